@@ -0,0 +1,59 @@
+#include "deque.hpp"
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+
+// Runs a FIFO work queue that holds a steady number of items, popping one from the front and
+// pushing one at the back per step, on mystd::deque, std::deque and mystd::vector with
+// erase(begin()).
+
+namespace {
+
+constexpr std::size_t total_steps = std::size_t{1} << 24;
+
+template <typename Queue> void pop(Queue &queue) {
+    if constexpr (requires { queue.pop_front(); }) {
+        queue.pop_front();
+    } else {
+        queue.erase(queue.begin());
+    }
+}
+
+template <typename Queue> double queue_ns(std::size_t depth, std::size_t steps) {
+    Queue queue;
+    for (std::size_t i = 0; i < depth; ++i) {
+        queue.push_back(static_cast<std::uint64_t>(i));
+    }
+
+    std::uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < steps; ++i) {
+        checksum += queue.front();
+        pop(queue);
+        queue.push_back(static_cast<std::uint64_t>(i));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    if (checksum == 0) {
+        std::printf("unexpected checksum\n");
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count() / steps;
+}
+
+} // namespace
+
+int main() {
+    std::printf("%10s  %12s  %12s  %12s\n", "depth", "mystd", "std", "vector");
+    for (std::size_t depth = 16; depth <= (std::size_t{1} << 16); depth *= 16) {
+        double mine = queue_ns<mystd::deque<std::uint64_t>>(depth, total_steps);
+        double theirs = queue_ns<std::deque<std::uint64_t>>(depth, total_steps);
+
+        // Erasing from the front of a vector is O(depth), so it runs fewer steps.
+        double vector = queue_ns<mystd::vector<std::uint64_t>>(depth, total_steps / depth);
+        std::printf("%10zu  %9.2f ns  %9.2f ns  %9.2f ns\n", depth, mine, theirs, vector);
+    }
+}
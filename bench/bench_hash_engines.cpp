@@ -0,0 +1,74 @@
+#include "unordered_set.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Compares successful and failed lookups in the chained and cuckoo engines at fixed load factors.
+// Both engines get 2^20 slots up front, and the load factor decides how many keys are inserted.
+
+namespace {
+
+constexpr std::size_t slot_count = 1 << 20;
+constexpr int lookup_rounds = 4;
+
+std::vector<std::uint64_t> make_keys(std::size_t count, std::uint64_t seed) {
+    std::vector<std::uint64_t> keys(count);
+    for (auto &key : keys) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        key = seed;
+    }
+    return keys;
+}
+
+template <typename Set>
+double lookup_ns(const Set &set, const std::vector<std::uint64_t> &keys, std::size_t &found) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < lookup_rounds; ++round) {
+        for (auto key : keys) {
+            found += set.contains(key);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           (lookup_rounds * keys.size());
+}
+
+template <typename Set>
+void run(const char *name, std::size_t bucket_count, const std::vector<std::uint64_t> &present,
+         const std::vector<std::uint64_t> &absent) {
+    Set set;
+    set.max_load_factor(1.0f);
+    set.rehash(bucket_count);
+    for (auto key : present) {
+        set.insert(key);
+    }
+
+    std::size_t found = 0;
+    double hit = lookup_ns(set, present, found);
+    double miss = lookup_ns(set, absent, found);
+
+    std::printf("%-8s lf=%.2f  hit %6.1f ns  miss %6.1f ns  [%zu]\n", name, set.load_factor(),
+                hit, miss, found);
+}
+
+} // namespace
+
+int main() {
+    using chained = mystd::unordered_set<std::uint64_t>;
+    using cuckoo =
+        mystd::unordered_set<std::uint64_t, std::hash<std::uint64_t>, mystd::cuckoo_hashing>;
+
+    for (double lf : {0.5, 0.75, 0.9, 0.95}) {
+        auto count = static_cast<std::size_t>(lf * slot_count);
+        auto present = make_keys(count, 1);
+        auto absent = make_keys(count, 2);
+
+        // A chained bucket holds one element at load factor 1, a cuckoo bucket holds four.
+        run<chained>("chained", slot_count, present, absent);
+        run<cuckoo>("cuckoo", slot_count / 4, present, absent);
+    }
+}
@@ -0,0 +1,52 @@
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Compares push_back loops into mystd::vector and std::vector, starting from empty each round so
+// that growth is included, for int and std::string elements.
+
+namespace {
+
+constexpr std::size_t total_elements = std::size_t{1} << 26;
+
+template <typename Vector, typename Make> double push_back_ns(std::size_t count, Make make) {
+    std::size_t rounds = total_elements / count;
+    std::size_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        Vector vec;
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.push_back(make(i));
+        }
+        checksum += vec.size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    if (checksum != rounds * count) {
+        std::printf("unexpected size\n");
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (rounds * count);
+}
+
+template <typename T, typename Make> void run(const char *name, Make make) {
+    std::printf("%s\n%10s  %12s  %12s\n", name, "elements", "mystd", "std");
+    for (std::size_t count = 16; count <= (std::size_t{1} << 22); count *= 8) {
+        double mine = push_back_ns<mystd::vector<T>>(count, make);
+        double theirs = push_back_ns<std::vector<T>>(count, make);
+        std::printf("%10zu  %9.2f ns  %9.2f ns\n", count, mine, theirs);
+    }
+}
+
+} // namespace
+
+int main() {
+    run<std::uint32_t>("uint32_t", [](std::size_t i) { return static_cast<std::uint32_t>(i); });
+    run<std::string>("std::string (SSO)",
+                     [](std::size_t i) { return std::string(8, static_cast<char>('a' + i % 26)); });
+}
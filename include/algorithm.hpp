@@ -1,14 +1,95 @@
 #pragma once
 
+#include "bits/iterator_base_types.hpp"
 #include "bits/iterator_concepts.hpp"
 #include "utility.hpp"
+
 #include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 
 namespace mystd {
 
+namespace detail {
+
+// True when [first, last) may be copied into O by copying bytes: both iterators are contiguous
+// over the same trivially copyable type. Callers additionally check that the particular
+// assignment or construction they replace is trivial.
+template <typename I, typename O>
+concept bitwise_copyable =
+    mystd::contiguous_iterator<I> && mystd::contiguous_iterator<O> &&
+    std::same_as<typename mystd::iterator_traits<I>::value_type,
+                 typename mystd::iterator_traits<O>::value_type> &&
+    !std::is_const_v<std::remove_reference_t<typename mystd::iterator_traits<O>::reference>> &&
+    std::is_trivially_copyable_v<typename mystd::iterator_traits<O>::value_type>;
+
+template <typename I, typename O, typename Source>
+concept bitwise_assignable =
+    bitwise_copyable<I, O> &&
+    std::is_trivially_assignable_v<typename mystd::iterator_traits<O>::value_type &, Source>;
+
+// Copies the bytes of [first, last) to d_first, which may overlap, returning the end of the
+// destination.
+template <typename I, typename O> O bitwise_copy(I first, I last, O d_first) noexcept {
+    auto count = last - first;
+    if (count > 0) {
+        std::memmove(static_cast<void *>(mystd::to_address(d_first)),
+                     static_cast<const void *>(mystd::to_address(first)),
+                     static_cast<std::size_t>(count) *
+                         sizeof(typename mystd::iterator_traits<O>::value_type));
+    }
+
+    return d_first + count;
+}
+
+// Returns the byte every byte of value is equal to, or -1 if they differ.
+template <typename T> int repeated_byte(const T &value) noexcept {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+
+    for (std::size_t i = 1; i < sizeof(T); ++i) {
+        if (bytes[i] != bytes[0]) {
+            return -1;
+        }
+    }
+    return bytes[0];
+}
+
+// Fills a contiguous range of scalars with memset if value converts to a single repeated byte,
+// which covers zeroing and all byte-sized types. Returns whether it did.
+template <typename I, typename T> bool bitwise_fill(I first, I last, const T &value) noexcept {
+    using value_type = typename mystd::iterator_traits<I>::value_type;
+    using reference = typename mystd::iterator_traits<I>::reference;
+
+    if constexpr (mystd::contiguous_iterator<I> && std::is_scalar_v<value_type> &&
+                  !std::is_const_v<std::remove_reference_t<reference>>) {
+        value_type converted = value;
+        int byte = repeated_byte(converted);
+        if (byte < 0) {
+            return false;
+        }
+
+        if (first != last) {
+            std::memset(static_cast<void *>(mystd::to_address(first)), byte,
+                        static_cast<std::size_t>(last - first) * sizeof(value_type));
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
+} // namespace detail
+
 template <mystd::input_iterator I,
           mystd::output_iterator<typename mystd::iterator_traits<I>::value_type &&> O>
 O move(I first, I last, O d_first) {
+    using value_type = typename mystd::iterator_traits<I>::value_type;
+    if constexpr (detail::bitwise_assignable<I, O, value_type &&>) {
+        return detail::bitwise_copy(first, last, d_first);
+    }
+
     for (; first != last; ++first, ++d_first) {
         *d_first = mystd::move(*first);
     }
@@ -18,6 +99,13 @@ O move(I first, I last, O d_first) {
 
 template <mystd::bidirectional_iterator I, mystd::bidirectional_iterator O>
 O move_backward(I first, I last, O d_last) {
+    using value_type = typename mystd::iterator_traits<I>::value_type;
+    if constexpr (detail::bitwise_assignable<I, O, value_type &&>) {
+        auto d_first = d_last - (last - first);
+        detail::bitwise_copy(first, last, d_first);
+        return d_first;
+    }
+
     while (first != last) {
         *(--d_last) = mystd::move(*--last);
     }
@@ -28,6 +116,11 @@ O move_backward(I first, I last, O d_last) {
 template <mystd::forward_iterator I,
           mystd::output_iterator<typename mystd::iterator_traits<I>::value_type> O>
 O copy(I first, I last, O d_first) {
+    using value_type = typename mystd::iterator_traits<I>::value_type;
+    if constexpr (detail::bitwise_assignable<I, O, const value_type &>) {
+        return detail::bitwise_copy(first, last, d_first);
+    }
+
     for (; first != last; ++first, ++d_first) {
         *d_first = *first;
     }
@@ -36,6 +129,10 @@ O copy(I first, I last, O d_first) {
 }
 
 template <mystd::forward_iterator I, typename T> void fill(I first, I last, const T &value) {
+    if (detail::bitwise_fill(first, last, value)) {
+        return;
+    }
+
     for (; first != last; ++first) {
         *first = value;
     }
@@ -3,12 +3,24 @@
 #include "utility.hpp"
 
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <new>
 #include <type_traits>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 namespace mystd {
 
+// NOTE: Memory comes from malloc() so that containers of trivially relocatable elements can grow
+// with realloc(), which extends the block in place when the heap allows and otherwise moves it
+// without an extra copy through the container. Over-aligned types use aligned operator new.
 template <typename T> class allocator {
+    static constexpr bool _over_aligned = alignof(T) > alignof(std::max_align_t);
+
 public:
     using value_type = T;
     using size_type = std::size_t;
@@ -22,8 +34,62 @@ public:
 
     ~allocator() = default;
 
-    T *allocate(size_type n) { return static_cast<T *>(::operator new(sizeof(T) * n)); }
-    void deallocate(T *p, size_type n) { ::operator delete(p); }
+    T *allocate(size_type n) {
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        if constexpr (_over_aligned) {
+            return static_cast<T *>(::operator new(sizeof(T) * n, std::align_val_t(alignof(T))));
+        } else {
+            void *p = std::malloc(n == 0 ? 1 : sizeof(T) * n);
+            if (!p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(p);
+        }
+    }
+
+    void deallocate(T *p, size_type n) {
+        if constexpr (_over_aligned) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            std::free(p);
+        }
+    }
+
+    // Grows the block at p to hold new_n elements without moving it, if the heap already set
+    // aside enough room for it.
+    bool try_expand([[maybe_unused]] T *p, size_type, [[maybe_unused]] size_type new_n) noexcept {
+#if defined(__GLIBC__)
+        if constexpr (!_over_aligned) {
+            return new_n <= ::malloc_usable_size(p) / sizeof(T);
+        }
+#endif
+        return false;
+    }
+
+    // Resizes the block at p to new_n elements, moving its bytes if it cannot grow in place. On
+    // failure p is left untouched. Only valid for trivially relocatable T.
+    T *reallocate(T *p, [[maybe_unused]] size_type old_n, size_type new_n) {
+        if (new_n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        if constexpr (_over_aligned) {
+            T *new_p = allocate(new_n);
+            std::memcpy(static_cast<void *>(new_p), static_cast<const void *>(p),
+                        sizeof(T) * (old_n < new_n ? old_n : new_n));
+            deallocate(p, old_n);
+            return new_p;
+        } else {
+            void *new_p = std::realloc(static_cast<void *>(p), new_n == 0 ? 1 : sizeof(T) * new_n);
+            if (!new_p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(new_p);
+        }
+    }
 };
 
 template <typename T1, typename T2>
@@ -81,10 +147,36 @@ template <typename A> struct allocator_traits {
     static pointer allocate(A &a, size_type n) { return a.allocate(n); }
     static void deallocate(A &a, pointer p, size_type n) { a.deallocate(p, n); }
 
-    template <typename T, typename... Args> static void construct(A &a, T *p, Args &&...args) {
+    // Extends the allocation at p from old_n to new_n elements in place, returning whether it
+    // did. Allocators opt in by providing try_expand(); otherwise nothing ever grows in place.
+    static bool try_expand(A &a, pointer p, size_type old_n, size_type new_n) noexcept {
+        if constexpr (requires { a.try_expand(p, old_n, new_n); }) {
+            return a.try_expand(p, old_n, new_n);
+        } else {
+            return false;
+        }
+    }
+
+    // Moves the allocation at p to one of new_n elements by copying its bytes, so the elements
+    // must be trivially relocatable. Allocators may provide reallocate() to do this in place
+    // (e.g. with realloc()); otherwise the elements are copied to a fresh allocation and p is
+    // freed. On failure p is left untouched.
+    static pointer reallocate(A &a, pointer p, size_type old_n, size_type new_n) {
+        if constexpr (requires { a.reallocate(p, old_n, new_n); }) {
+            return a.reallocate(p, old_n, new_n);
+        } else {
+            pointer new_p = a.allocate(new_n);
+            std::memcpy(static_cast<void *>(new_p), static_cast<const void *>(p),
+                        sizeof(value_type) * (old_n < new_n ? old_n : new_n));
+            a.deallocate(p, old_n);
+            return new_p;
+        }
+    }
+
+    template <typename T, typename... Args> static void construct(A &, T *p, Args &&...args) {
         ::new (static_cast<void *>(p)) T(mystd::forward<Args>(args)...);
     }
-    template <typename T> static void destroy(A &a, T *p) { p->~T(); }
+    template <typename T> static void destroy(A &, T *p) { p->~T(); }
 
     static A select_on_container_copy_construction(const A &a) { return a; }
 };
@@ -0,0 +1,842 @@
+#pragma once
+
+#include "bits/hashed_key.hpp"
+#include "bits/hashtable.hpp"
+#include "bits/iterator_base_types.hpp"
+#include "bits/iterator_concepts.hpp"
+#include "bits/key_traits.hpp"
+#include "hyperloglog.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mystd::detail {
+
+template <typename V> struct cuckoo_bucket {
+    static constexpr std::size_t slots = 4;
+
+    // A zero tag marks an empty slot.
+    std::uint8_t tags[slots]{};
+    alignas(V) unsigned char storage[slots][sizeof(V)];
+
+    V *value(std::size_t slot) noexcept {
+        return std::launder(reinterpret_cast<V *>(storage[slot]));
+    }
+    const V *value(std::size_t slot) const noexcept {
+        return std::launder(reinterpret_cast<const V *>(storage[slot]));
+    }
+
+    // Returns a mask with bit i set iff tags[i] == tag.
+    unsigned match(std::uint8_t tag) const noexcept {
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < slots; ++i) {
+            mask |= unsigned{tags[i] == tag} << i;
+        }
+        return mask;
+    }
+
+    std::size_t free_slot() const noexcept {
+        for (std::size_t i = 0; i < slots; ++i) {
+            if (tags[i] == 0) {
+                return i;
+            }
+        }
+        return slots;
+    }
+};
+
+// Iterates the table's slots in order, followed by its stash.
+template <typename Table, bool IsConst = false> class cuckoo_iterator {
+    template <typename, bool> friend class cuckoo_iterator;
+    friend Table;
+
+    using _table_type = std::conditional_t<IsConst, const Table, Table>;
+
+    _table_type *_table{};
+    std::size_t _pos{};
+
+public:
+    using iterator_category = mystd::forward_iterator_tag;
+    using value_type = typename Table::value_type;
+    using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+    using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+    using difference_type = std::ptrdiff_t;
+
+    cuckoo_iterator() = default;
+    cuckoo_iterator(_table_type *table, std::size_t pos) : _table(table), _pos(pos) {}
+    template <bool OtherConst>
+    cuckoo_iterator(const cuckoo_iterator<Table, OtherConst> &other)
+        requires(IsConst || !OtherConst)
+        : _table(other._table), _pos(other._pos) {}
+
+    cuckoo_iterator &operator++() noexcept {
+        _pos = _table->_next_occupied(_pos + 1);
+        return *this;
+    }
+
+    cuckoo_iterator operator++(int) noexcept {
+        cuckoo_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    reference operator*() const noexcept { return *_table->_value_at(_pos); }
+    pointer operator->() const noexcept { return _table->_value_at(_pos); }
+
+    template <bool OtherConst>
+    friend bool operator==(const cuckoo_iterator &lhs,
+                           const cuckoo_iterator<Table, OtherConst> &rhs) {
+        return lhs._pos == rhs._pos;
+    }
+};
+
+// Iterates the occupied slots of one bucket; stashed elements belong to no bucket.
+template <typename V, bool IsConst = false> class cuckoo_local_iterator {
+    template <typename, bool> friend class cuckoo_local_iterator;
+
+    using _bucket_type = std::conditional_t<IsConst, const cuckoo_bucket<V>, cuckoo_bucket<V>>;
+
+    _bucket_type *_bucket{};
+    std::size_t _slot{};
+
+public:
+    using iterator_category = mystd::forward_iterator_tag;
+    using value_type = V;
+    using pointer = std::conditional_t<IsConst, const V *, V *>;
+    using reference = std::conditional_t<IsConst, const V &, V &>;
+    using difference_type = std::ptrdiff_t;
+
+    cuckoo_local_iterator() = default;
+    cuckoo_local_iterator(_bucket_type *bucket, std::size_t slot) : _bucket(bucket), _slot(slot) {
+        _skip_empty();
+    }
+    template <bool OtherConst>
+    cuckoo_local_iterator(const cuckoo_local_iterator<V, OtherConst> &other)
+        requires(IsConst || !OtherConst)
+        : _bucket(other._bucket), _slot(other._slot) {}
+
+    cuckoo_local_iterator &operator++() noexcept {
+        ++_slot;
+        _skip_empty();
+        return *this;
+    }
+
+    cuckoo_local_iterator operator++(int) noexcept {
+        cuckoo_local_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    reference operator*() const noexcept { return *_bucket->value(_slot); }
+    pointer operator->() const noexcept { return _bucket->value(_slot); }
+
+    template <bool OtherConst>
+    friend bool operator==(const cuckoo_local_iterator &lhs,
+                           const cuckoo_local_iterator<V, OtherConst> &rhs) {
+        return lhs._bucket == rhs._bucket && lhs._slot == rhs._slot;
+    }
+
+private:
+    void _skip_empty() noexcept {
+        while (_slot < cuckoo_bucket<V>::slots && _bucket->tags[_slot] == 0) {
+            ++_slot;
+        }
+    }
+};
+
+// NOTE: Bucketised cuckoo hashing: each key has two candidate buckets of four slots, so a lookup
+// inspects at most two buckets (plus a small stash which is almost always empty). Slots carry
+// 8-bit tags, and a key's alternate bucket is derived from its current bucket and tag alone, so
+// elements are displaced without rehashing their keys. Insertion searches breadth-first for the
+// shortest chain of displacements ending in a free slot, falling back to the stash and then to
+// rehashing under a fresh seed, doubling the table only after repeated reseeds. Keys whose full
+// hashes collide share both buckets under every seed, so once those are full such keys overflow
+// into the stash instead. Unlike the chained hashtable, elements live in the bucket array itself,
+// so any insertion may move elements and invalidates iterators and references.
+//
+// load_factor() is the fraction of slots in use, i.e. size() / (4 * bucket_count()).
+template <typename V, typename KeyExtractor, typename Hash> class cuckoo_table {
+    static constexpr bool is_set = std::is_same_v<KeyExtractor, key_extractor_identity>;
+
+    template <typename, typename, typename> friend class cuckoo_table;
+    template <typename, bool> friend class cuckoo_iterator;
+
+public:
+    using value_type = V;
+    using key_type =
+        std::remove_cvref_t<decltype(std::declval<KeyExtractor>()(std::declval<value_type>()))>;
+    using size_type = std::size_t;
+    using iterator = cuckoo_iterator<cuckoo_table, is_set>;
+    using const_iterator = cuckoo_iterator<cuckoo_table, true>;
+    using local_iterator = cuckoo_local_iterator<value_type, is_set>;
+    using const_local_iterator = cuckoo_local_iterator<value_type, true>;
+    using bucket_range = detail::bucket_range<iterator>;
+    using const_bucket_range = detail::bucket_range<const_iterator>;
+    using hashed_key_type = mystd::hashed_key<key_type, Hash>;
+
+private:
+    using _bucket_type = cuckoo_bucket<V>;
+
+    static constexpr size_type _slots = _bucket_type::slots;
+    static constexpr size_type _initial_bucket_count = 4;
+    static constexpr size_type _stash_capacity = 8;
+    static constexpr size_type _max_search_nodes = 256;
+    static constexpr size_type _max_reseeds = 3;
+    static constexpr size_type _ranges_per_thread = 8;
+
+    struct _probe {
+        size_type primary;
+        size_type alternate;
+        std::uint8_t tag;
+    };
+
+    struct _search_node {
+        size_type bucket;
+        size_type slot;
+        size_type parent;
+    };
+
+    static constexpr size_type _no_parent = std::numeric_limits<size_type>::max();
+
+    _bucket_type *_buckets{};
+    size_type _bucket_count{};
+    size_type _element_count{};
+    mystd::vector<value_type> _stash;
+    float _max_load_factor{0.9f};
+    std::uint64_t _seed{detail::next_hash_seed()};
+
+    Hash _hash{};
+    KeyExtractor _extract_key{};
+
+public:
+    cuckoo_table() = default;
+    cuckoo_table(size_type count) { rehash(count); }
+
+    cuckoo_table(const cuckoo_table &other)
+        : _stash(other._stash), _max_load_factor(other._max_load_factor), _seed(other._seed),
+          _hash(other._hash), _extract_key(other._extract_key) {
+        _allocate(other._bucket_count);
+
+        try {
+            for (size_type b = 0; b < _bucket_count; ++b) {
+                for (size_type s = 0; s < _slots; ++s) {
+                    if (other._buckets[b].tags[s]) {
+                        ::new (_buckets[b].storage[s]) value_type(*other._buckets[b].value(s));
+                        _buckets[b].tags[s] = other._buckets[b].tags[s];
+                    }
+                }
+            }
+        } catch (...) {
+            _destroy();
+            throw;
+        }
+
+        _element_count = other._element_count;
+    }
+
+    cuckoo_table(cuckoo_table &&other) noexcept
+        : _buckets(mystd::exchange(other._buckets, nullptr)),
+          _bucket_count(mystd::exchange(other._bucket_count, 0)),
+          _element_count(mystd::exchange(other._element_count, 0)),
+          _stash(mystd::move(other._stash)), _max_load_factor(other._max_load_factor),
+          _seed(other._seed), _hash(other._hash), _extract_key(other._extract_key) {}
+
+    ~cuckoo_table() { _destroy(); }
+
+    cuckoo_table &operator=(const cuckoo_table &other) {
+        if (this != &other) {
+            cuckoo_table temp(other);
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    cuckoo_table &operator=(cuckoo_table &&other) noexcept {
+        if (this != &other) {
+            cuckoo_table temp(mystd::move(other));
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    // Iterators.
+    iterator begin() noexcept { return iterator(this, _next_occupied(0)); }
+    const_iterator begin() const noexcept { return const_iterator(this, _next_occupied(0)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(this, _end_pos()); }
+    const_iterator end() const noexcept { return const_iterator(this, _end_pos()); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Capacity.
+    bool empty() const noexcept { return _element_count == 0; }
+    size_type size() const noexcept { return _element_count; }
+    size_type max_size() const noexcept { return std::numeric_limits<size_type>::max(); }
+
+    // Modifiers.
+    template <typename... Args>
+        requires(!detail::starts_with_hashed_key<Args...>)
+    std::pair<iterator, bool> emplace(Args &&...args) {
+        value_type data(mystd::forward<Args>(args)...);
+        size_type hash = _hash(_extract_key(data));
+
+        return _emplace(hash, mystd::move(data));
+    }
+
+    // NOTE: The element is only constructed if the key is not already present.
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const hashed_key_type &hk, Args &&...args) {
+        if (size_type pos = _find(hk.key, hk.hash); pos != _end_pos()) {
+            return {iterator(this, pos), false};
+        }
+
+        value_type data(hk.key, mystd::forward<Args>(args)...);
+        return {iterator(this, _insert(mystd::move(data), hk.hash)), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value) { return emplace(value); }
+    std::pair<iterator, bool> insert(value_type &&value) { return emplace(std::move(value)); }
+
+    template <mystd::input_iterator I> void insert(I first, I last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+    void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+
+    iterator erase(const_iterator pos) { return iterator(this, _erase_at(pos._pos)); }
+
+    iterator erase(iterator pos)
+        requires(!is_set || !std::same_as<iterator, const_iterator>)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        // Erasing from the stash moves the end, so count the elements first.
+        size_type count = 0;
+        for (auto it = first; it != last; ++it) {
+            ++count;
+        }
+
+        iterator it(this, first._pos);
+        for (; count > 0; --count) {
+            it = erase(it);
+        }
+        return it;
+    }
+
+    size_type erase(const key_type &key) { return _erase(key, _hash(key)); }
+    size_type erase(const hashed_key_type &hk) { return _erase(hk.key, hk.hash); }
+
+    void clear() noexcept {
+        for (size_type b = 0; b < _bucket_count; ++b) {
+            for (size_type s = 0; s < _slots; ++s) {
+                if (_buckets[b].tags[s]) {
+                    _buckets[b].value(s)->~value_type();
+                    _buckets[b].tags[s] = 0;
+                }
+            }
+        }
+
+        _stash.clear();
+        _element_count = 0;
+    }
+
+    void swap(cuckoo_table &other) noexcept {
+        mystd::swap(_buckets, other._buckets);
+        mystd::swap(_bucket_count, other._bucket_count);
+        mystd::swap(_element_count, other._element_count);
+        _stash.swap(other._stash);
+        mystd::swap(_max_load_factor, other._max_load_factor);
+        mystd::swap(_seed, other._seed);
+        mystd::swap(_hash, other._hash);
+        mystd::swap(_extract_key, other._extract_key);
+    }
+
+    // NOTE: Elements whose keys are already present are left in other, as with the chained
+    // hashtable.
+    template <typename H> void merge(cuckoo_table<V, KeyExtractor, H> &other) {
+        for (size_type pos = other._next_occupied(0); pos != other._end_pos();) {
+            value_type &value = *other._value_at(pos);
+            size_type hash = _hash(_extract_key(value));
+
+            if (_find(_extract_key(value), hash) != _end_pos()) {
+                pos = other._next_occupied(pos + 1);
+                continue;
+            }
+
+            _insert(mystd::move(value), hash);
+            pos = other._erase_at(pos);
+        }
+    }
+
+    // Lookup.
+    iterator find(const key_type &key) noexcept { return iterator(this, _find(key, _hash(key))); }
+    iterator find(const hashed_key_type &hk) noexcept {
+        return iterator(this, _find(hk.key, hk.hash));
+    }
+
+    const_iterator find(const key_type &key) const noexcept {
+        return const_cast<cuckoo_table *>(this)->find(key);
+    }
+    const_iterator find(const hashed_key_type &hk) const noexcept {
+        return const_cast<cuckoo_table *>(this)->find(hk);
+    }
+
+    bool contains(const key_type &key) const noexcept { return find(key) != end(); }
+    bool contains(const hashed_key_type &hk) const noexcept { return find(hk) != end(); }
+
+    size_type count(const key_type &key) const noexcept { return contains(key) ? 1 : 0; }
+    size_type count(const hashed_key_type &hk) const noexcept { return contains(hk) ? 1 : 0; }
+
+    std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
+        return _equal_range(find(key));
+    }
+    std::pair<iterator, iterator> equal_range(const hashed_key_type &hk) noexcept {
+        return _equal_range(find(hk));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const noexcept {
+        auto [first, last] = const_cast<cuckoo_table *>(this)->equal_range(key);
+        return {first, last};
+    }
+    std::pair<const_iterator, const_iterator>
+    equal_range(const hashed_key_type &hk) const noexcept {
+        auto [first, last] = const_cast<cuckoo_table *>(this)->equal_range(hk);
+        return {first, last};
+    }
+
+    // Buckets.
+    local_iterator begin(size_type bucket) noexcept { return local_iterator(&_buckets[bucket], 0); }
+    const_local_iterator begin(size_type bucket) const noexcept {
+        return const_local_iterator(&_buckets[bucket], 0);
+    }
+    const_local_iterator cbegin(size_type bucket) const noexcept { return begin(bucket); }
+
+    local_iterator end(size_type bucket) noexcept {
+        return local_iterator(&_buckets[bucket], _slots);
+    }
+    const_local_iterator end(size_type bucket) const noexcept {
+        return const_local_iterator(&_buckets[bucket], _slots);
+    }
+    const_local_iterator cend(size_type bucket) const noexcept { return end(bucket); }
+
+    size_type bucket_count() const noexcept { return _bucket_count; }
+    size_type max_bucket_count() const noexcept { return std::numeric_limits<size_type>::max(); }
+    size_type bucket(const key_type &key) const noexcept { return _probe_of(_hash(key)).primary; }
+    size_type bucket(const hashed_key_type &hk) const noexcept {
+        return _probe_of(hk.hash).primary;
+    }
+    size_type bucket_size(size_type bucket) const noexcept {
+        return _slots - std::popcount(_buckets[bucket].match(0));
+    }
+
+    // Parallel iteration.
+    // NOTE: Splits the buckets into up to count contiguous ranges, the last of which also covers
+    // the stash. The ranges visit disjoint elements, so each may be walked on its own thread
+    // while the table is not being modified.
+    mystd::vector<bucket_range> bucket_ranges(size_type count) {
+        return _bucket_ranges<bucket_range>(this, count);
+    }
+    mystd::vector<const_bucket_range> bucket_ranges(size_type count) const {
+        return _bucket_ranges<const_bucket_range>(this, count);
+    }
+
+    // Calls fn(element) for every element on up to `threads` threads, in no particular order.
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) {
+        _for_each_parallel(bucket_ranges(threads * _ranges_per_thread), fn, threads);
+    }
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) const {
+        _for_each_parallel(bucket_ranges(threads * _ranges_per_thread), fn, threads);
+    }
+
+    // Hashing.
+    float load_factor() const noexcept {
+        return _bucket_count ? static_cast<float>(size()) / _slot_count() : 0.0f;
+    }
+    float max_load_factor() const noexcept { return _max_load_factor; }
+    void max_load_factor(float ml) noexcept { _max_load_factor = std::min(ml, 1.0f); }
+    std::uint64_t seed() const noexcept { return _seed; }
+
+    // NOTE: Bucket counts are rounded up to a power of two.
+    void rehash(size_type count) {
+        size_type needed =
+            static_cast<size_type>(std::ceil(size() / (max_load_factor() * _slots)));
+        _rehash(std::bit_ceil(std::max({count, needed, size_type{1}})), _seed);
+    }
+
+    void reserve(size_type count) {
+        rehash(static_cast<size_type>(std::ceil(count / (max_load_factor() * _slots))));
+    }
+
+    // NOTE: Reserves for the number of distinct keys in [first, last), estimated by a HyperLogLog
+    // pass over their hashes, so a bulk load of a duplicate-heavy range rehashes at most once.
+    // The range is traversed here and again by the load, so it must be a forward range.
+    template <mystd::forward_iterator I> void reserve_estimated(I first, I last) {
+        reserve(detail::estimate_distinct_keys<key_type>(first, last, _hash, _extract_key));
+    }
+
+private:
+    size_type _slot_count() const noexcept { return _bucket_count * _slots; }
+    size_type _end_pos() const noexcept { return _slot_count() + _stash.size(); }
+
+    value_type *_value_at(size_type pos) const noexcept {
+        if (pos < _slot_count()) {
+            return const_cast<value_type *>(_buckets[pos / _slots].value(pos % _slots));
+        }
+        return const_cast<value_type *>(&_stash[pos - _slot_count()]);
+    }
+
+    size_type _next_occupied(size_type pos) const noexcept {
+        for (size_type slot_count = _slot_count(); pos < slot_count; ++pos) {
+            if (_buckets[pos / _slots].tags[pos % _slots]) {
+                return pos;
+            }
+        }
+        return std::min(pos, _end_pos());
+    }
+
+    template <typename Range, typename Self>
+    static mystd::vector<Range> _bucket_ranges(Self *self, size_type count) {
+        using range_iterator = typename Range::iterator;
+
+        size_type bucket_count = self->_bucket_count;
+        count = std::clamp(count, size_type{1}, std::max(bucket_count, size_type{1}));
+        mystd::vector<Range> ranges;
+        ranges.reserve(count);
+
+        for (size_type i = 0; i < count; ++i) {
+            size_type first = i * bucket_count / count * _slots;
+            size_type last =
+                i + 1 == count ? self->_end_pos() : (i + 1) * bucket_count / count * _slots;
+            ranges.push_back({range_iterator(self, self->_next_occupied(first)),
+                              range_iterator(self, self->_next_occupied(last))});
+        }
+
+        return ranges;
+    }
+
+    template <typename Ranges, typename Fn>
+    static void _for_each_parallel(const Ranges &ranges, Fn &fn, size_type threads) {
+        detail::for_each_partition(ranges.size(), threads, [&](size_type r) {
+            for (auto &value : ranges[r]) {
+                fn(value);
+            }
+        });
+    }
+
+    _probe _probe_of(size_type hash) const noexcept {
+        std::uint64_t mixed = detail::mix_hash(hash ^ _seed);
+        auto tag = static_cast<std::uint8_t>(mixed >> 56);
+        tag += tag == 0;
+
+        size_type primary = mixed & (_bucket_count - 1);
+        return {primary, _alternate(primary, tag), tag};
+    }
+
+    // An involution: the alternate of the alternate bucket is the original bucket.
+    size_type _alternate(size_type bucket, std::uint8_t tag) const noexcept {
+        return (bucket ^ (tag * 0xC6A4A7935BD1E995ull)) & (_bucket_count - 1);
+    }
+
+    size_type _find(const key_type &key, size_type hash) const noexcept {
+        if (empty()) {
+            return _end_pos();
+        }
+
+        _probe probe = _probe_of(hash);
+        for (size_type b : {probe.primary, probe.alternate}) {
+            const _bucket_type &bucket = _buckets[b];
+
+            for (unsigned matches = bucket.match(probe.tag); matches; matches &= matches - 1) {
+                size_type s = std::countr_zero(matches);
+                if (_extract_key(*bucket.value(s)) == key) {
+                    return b * _slots + s;
+                }
+            }
+        }
+
+        for (size_type i = 0; i < _stash.size(); ++i) {
+            if (_extract_key(_stash[i]) == key) {
+                return _slot_count() + i;
+            }
+        }
+
+        return _end_pos();
+    }
+
+    std::pair<iterator, iterator> _equal_range(iterator first) noexcept {
+        return {first, first == end() ? end() : mystd::next(first)};
+    }
+
+    std::pair<iterator, bool> _emplace(size_type hash, value_type &&data) {
+        if (size_type pos = _find(_extract_key(data), hash); pos != _end_pos()) {
+            return {iterator(this, pos), false};
+        }
+
+        return {iterator(this, _insert(mystd::move(data), hash)), true};
+    }
+
+    size_type _erase(const key_type &key, size_type hash) {
+        size_type pos = _find(key, hash);
+        if (pos == _end_pos()) {
+            return 0;
+        }
+
+        _erase_at(pos);
+        return 1;
+    }
+
+    // Returns the position of the element following the erased one.
+    size_type _erase_at(size_type pos) {
+        size_type slot_count = _slot_count();
+
+        if (pos < slot_count) {
+            _bucket_type &bucket = _buckets[pos / _slots];
+            bucket.value(pos % _slots)->~value_type();
+            bucket.tags[pos % _slots] = 0;
+            --_element_count;
+
+            return _next_occupied(pos + 1);
+        }
+
+        // Later stash elements shift down into the erased position.
+        _stash.erase(_stash.begin() + (pos - slot_count));
+        --_element_count;
+
+        return pos;
+    }
+
+    // Inserts a value whose key is known to be absent, returning its position.
+    size_type _insert(value_type &&data, size_type hash) {
+        if (_bucket_count == 0) {
+            rehash(_initial_bucket_count);
+        } else if (size() + 1 > max_load_factor() * _slot_count()) {
+            rehash(2 * _bucket_count);
+        }
+
+        auto relocate = [this](size_type from, size_type to) { _relocate(from, to); };
+        auto hash_at = [this](size_type pos) { return _hash(_extract_key(*_value_at(pos))); };
+
+        while (true) {
+            _probe probe = _probe_of(hash);
+
+            if (auto [bucket, slot] = _make_room(probe, relocate); slot != _slots) {
+                ::new (_buckets[bucket].storage[slot]) value_type(mystd::move(data));
+                _buckets[bucket].tags[slot] = probe.tag;
+                ++_element_count;
+
+                return bucket * _slots + slot;
+            }
+
+            if (_stash.size() < _stash_capacity || _saturated(probe, hash, hash_at)) {
+                _stash.push_back(mystd::move(data));
+                ++_element_count;
+
+                return _end_pos() - 1;
+            }
+
+            // The collision is an accident of the seed, so try another before growing.
+            _rehash(_bucket_count, detail::next_hash_seed());
+        }
+    }
+
+    // Rebuilds the table with bucket_count buckets under seed. Whenever the elements do not fit,
+    // a fresh seed is drawn, and the bucket count doubles after every _max_reseeds seeds.
+    void _rehash(size_type bucket_count, std::uint64_t seed) {
+        for (size_type attempt = 1; !_rebuild(bucket_count, seed); ++attempt) {
+            seed = detail::next_hash_seed();
+            if (attempt % _max_reseeds == 0) {
+                bucket_count *= 2;
+            }
+        }
+    }
+
+    // NOTE: Every element is placed in the new table by its tag alone before any is moved, so a
+    // placement that fails (returning false) or an element copy that throws leaves the table
+    // untouched. Elements are moved rather than copied when that cannot throw.
+    bool _rebuild(size_type bucket_count, std::uint64_t seed) {
+        cuckoo_table next;
+        next._max_load_factor = _max_load_factor;
+        next._seed = seed;
+        next._hash = _hash;
+        next._extract_key = _extract_key;
+        next._allocate(bucket_count);
+
+        // source[pos] is the position in *this of the element bound for slot pos of next.
+        mystd::vector<size_type> source(next._slot_count());
+        mystd::vector<size_type> stashed;
+        auto relocate = [&](size_type from, size_type to) { source[to] = source[from]; };
+        auto hash_at = [&](size_type pos) {
+            return _hash(_extract_key(*_value_at(source[pos])));
+        };
+
+        for (size_type pos = _next_occupied(0); pos != _end_pos(); pos = _next_occupied(pos + 1)) {
+            size_type hash = _hash(_extract_key(*_value_at(pos)));
+            _probe probe = next._probe_of(hash);
+
+            if (auto [bucket, slot] = next._make_room(probe, relocate); slot != _slots) {
+                next._buckets[bucket].tags[slot] = probe.tag;
+                source[bucket * _slots + slot] = pos;
+            } else if (stashed.size() < _stash_capacity ||
+                       next._saturated(probe, hash, hash_at)) {
+                stashed.push_back(pos);
+            } else {
+                return false;
+            }
+        }
+
+        next._stash.reserve(stashed.size());
+        size_type slot_count = next._slot_count();
+        size_type pos = 0;
+        try {
+            for (; pos < slot_count; ++pos) {
+                _bucket_type &bucket = next._buckets[pos / _slots];
+                if (bucket.tags[pos % _slots]) {
+                    ::new (bucket.storage[pos % _slots])
+                        value_type(_transfer(*_value_at(source[pos])));
+                }
+            }
+        } catch (...) {
+            // Untag the slots whose elements were never constructed.
+            for (; pos < slot_count; ++pos) {
+                next._buckets[pos / _slots].tags[pos % _slots] = 0;
+            }
+            throw;
+        }
+
+        for (size_type from : stashed) {
+            next._stash.push_back(_transfer(*_value_at(from)));
+        }
+
+        next._element_count = _element_count;
+        swap(next);
+        return true;
+    }
+
+    static decltype(auto) _transfer(value_type &value) noexcept {
+        if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                      !std::is_copy_constructible_v<value_type>) {
+            return mystd::move(value);
+        } else {
+            return static_cast<const value_type &>(value);
+        }
+    }
+
+    // True if both of the probe's buckets are full of elements sharing the full hash, which no
+    // seed or bucket count can separate, so another element with that hash must be stashed.
+    template <typename HashAt>
+    bool _saturated(const _probe &probe, size_type hash, HashAt &hash_at) const {
+        for (size_type b : {probe.primary, probe.alternate}) {
+            for (size_type s = 0; s < _slots; ++s) {
+                if (!_buckets[b].tags[s] || hash_at(b * _slots + s) != hash) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void _relocate(size_type from, size_type to) {
+        _bucket_type &source = _buckets[from / _slots];
+        ::new (_buckets[to / _slots].storage[to % _slots])
+            value_type(mystd::move(*source.value(from % _slots)));
+        source.value(from % _slots)->~value_type();
+    }
+
+    // Frees a slot in one of the probe's buckets, returning (bucket, _slots) on failure. Each
+    // displacement calls relocate(from, to) with slot positions to move the payload.
+    template <typename Relocate>
+    std::pair<size_type, size_type> _make_room(const _probe &probe, Relocate &relocate) {
+        for (size_type b : {probe.primary, probe.alternate}) {
+            if (size_type s = _buckets[b].free_slot(); s != _slots) {
+                return {b, s};
+            }
+        }
+
+        // Breadth-first search for the shortest displacement path, starting from every slot of
+        // both buckets. A path never revisits a slot, so replaying it cannot clobber an element.
+        mystd::vector<_search_node> nodes;
+        for (size_type b : {probe.primary, probe.alternate}) {
+            for (size_type s = 0; s < _slots; ++s) {
+                nodes.push_back({b, s, _no_parent});
+            }
+        }
+
+        for (size_type head = 0; head < nodes.size(); ++head) {
+            _search_node node = nodes[head];
+            size_type alternate = _alternate(node.bucket, _buckets[node.bucket].tags[node.slot]);
+
+            if (size_type s = _buckets[alternate].free_slot(); s != _slots) {
+                return _displace(nodes, head, alternate, s, relocate);
+            }
+
+            for (size_type s = 0; s < _slots && nodes.size() < _max_search_nodes; ++s) {
+                if (!_on_path(nodes, head, alternate, s)) {
+                    nodes.push_back({alternate, s, head});
+                }
+            }
+        }
+
+        return {probe.primary, _slots};
+    }
+
+    static bool _on_path(const mystd::vector<_search_node> &nodes, size_type index,
+                         size_type bucket, size_type slot) noexcept {
+        for (; index != _no_parent; index = nodes[index].parent) {
+            if (nodes[index].bucket == bucket && nodes[index].slot == slot) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves each element on the path ending at nodes[index] one step along it, starting with
+    // the last into the free slot, and returns the slot vacated at the start of the path.
+    template <typename Relocate>
+    std::pair<size_type, size_type> _displace(const mystd::vector<_search_node> &nodes,
+                                              size_type index, size_type free_bucket,
+                                              size_type free_slot, Relocate &relocate) {
+        for (; index != _no_parent; index = nodes[index].parent) {
+            _bucket_type &from = _buckets[nodes[index].bucket];
+            size_type slot = nodes[index].slot;
+
+            relocate(nodes[index].bucket * _slots + slot, free_bucket * _slots + free_slot);
+            _buckets[free_bucket].tags[free_slot] = from.tags[slot];
+            from.tags[slot] = 0;
+
+            free_bucket = nodes[index].bucket;
+            free_slot = slot;
+        }
+
+        return {free_bucket, free_slot};
+    }
+
+    void _allocate(size_type count) {
+        _buckets = count ? new _bucket_type[count]() : nullptr;
+        _bucket_count = count;
+    }
+
+    void _destroy() noexcept {
+        clear();
+        delete[] _buckets;
+        _buckets = nullptr;
+        _bucket_count = 0;
+    }
+};
+
+} // namespace mystd::detail
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+
+namespace mystd {
+
+// NOTE: A growth policy decides the capacity a container grows to once it runs out of room:
+//
+//     static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+//                                      std::size_t element_size) noexcept;
+//
+// returns a capacity of at least required, given the current capacity and the element size in
+// bytes. Explicit reserve() calls bypass the policy.
+
+// Multiplies the capacity by Num / Den.
+template <std::size_t Num, std::size_t Den> struct geometric_growth {
+    static_assert(Num > Den && Den > 0, "mystd::geometric_growth must grow the capacity.");
+
+    static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                     std::size_t) noexcept {
+        std::size_t grown = capacity > std::numeric_limits<std::size_t>::max() / Num
+                                ? std::numeric_limits<std::size_t>::max()
+                                : capacity * Num / Den;
+
+        return std::max({grown, required, std::size_t{1}});
+    }
+};
+
+// Grows to exactly the required capacity, trading repeated reallocation for no slack.
+struct exact_growth {
+    static std::size_t next_capacity(std::size_t, std::size_t required, std::size_t) noexcept {
+        return required;
+    }
+};
+
+// Grows as Base does, then rounds the allocation up to the size class a malloc would serve it
+// from anyway: four classes per power of two up to a page, and whole pages beyond.
+template <typename Base = geometric_growth<3, 2>> struct size_class_growth {
+    static constexpr std::size_t page_size = 4096;
+    static constexpr std::size_t min_size = 16;
+
+    static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                     std::size_t element_size) noexcept {
+        std::size_t grown = Base::next_capacity(capacity, required, element_size);
+        if (grown > std::numeric_limits<std::size_t>::max() / element_size - page_size) {
+            return grown;
+        }
+
+        std::size_t bytes = grown * element_size;
+        if (bytes <= min_size) {
+            bytes = min_size;
+        } else if (bytes <= page_size) {
+            std::size_t step = std::bit_floor(bytes - 1) / 4;
+            bytes = (bytes + step - 1) & ~(step - 1);
+        } else {
+            bytes = (bytes + page_size - 1) & ~(page_size - 1);
+        }
+
+        return bytes / element_size;
+    }
+};
+
+using default_growth = geometric_growth<2, 1>;
+
+} // namespace mystd
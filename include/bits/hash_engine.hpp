@@ -0,0 +1,24 @@
+#pragma once
+
+#include "bits/cuckoo_table.hpp"
+#include "bits/hashtable.hpp"
+
+namespace mystd {
+
+// Engine selectors for unordered_set and unordered_map.
+
+// Separate chaining (the default): iterators and references stay valid across insertions.
+struct chained_hashing {
+    template <typename V, typename KeyExtractor, typename Hash, bool Unique>
+    using table = detail::hashtable<V, KeyExtractor, Hash, Unique>;
+};
+
+// Bucketised cuckoo hashing: a lookup probes at most two buckets, but insertions invalidate
+// iterators and references. Only unique keys are supported.
+struct cuckoo_hashing {
+    template <typename V, typename KeyExtractor, typename Hash, bool Unique>
+        requires Unique
+    using table = detail::cuckoo_table<V, KeyExtractor, Hash>;
+};
+
+} // namespace mystd
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace mystd {
+
+// NOTE: A key paired with its precomputed hash, so a key probed against several tables sharing
+// the same Hash is only hashed once. The key is held by reference and must outlive the token.
+template <typename K, typename Hash = std::hash<K>> struct hashed_key {
+    const K &key;
+    std::size_t hash;
+
+    explicit hashed_key(const K &key, const Hash &hasher = Hash()) : key(key), hash(hasher(key)) {}
+    hashed_key(const K &&, const Hash & = Hash()) = delete;
+
+    // Wraps a hash already computed with Hash, e.g. one stored alongside the key.
+    static hashed_key from_hash(const K &key, std::size_t hash) noexcept {
+        return hashed_key(key, hash, _precomputed{});
+    }
+
+private:
+    struct _precomputed {};
+    hashed_key(const K &key, std::size_t hash, _precomputed) noexcept : key(key), hash(hash) {}
+};
+
+namespace detail {
+
+template <typename T> struct is_hashed_key : std::false_type {};
+template <typename K, typename Hash> struct is_hashed_key<hashed_key<K, Hash>> : std::true_type {};
+
+template <typename... Args> inline constexpr bool starts_with_hashed_key = false;
+template <typename First, typename... Rest>
+inline constexpr bool starts_with_hashed_key<First, Rest...> =
+    is_hashed_key<std::remove_cvref_t<First>>::value;
+
+} // namespace detail
+
+} // namespace mystd
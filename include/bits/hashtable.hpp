@@ -1,14 +1,24 @@
 #pragma once
 
 #include "algorithm.hpp"
+#include "bits/hashed_key.hpp"
 #include "bits/hashtable_node.hpp"
+#include "bits/key_traits.hpp"
 #include "bits/iterator_concepts.hpp"
 #include "bits/iterator_functions.hpp"
+#include "bits/parallel.hpp"
+#include "hyperloglog.hpp"
 #include "utility.hpp"
+#include "vector.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <limits>
+#include <random>
 #include <type_traits>
 #include <utility>
 
@@ -24,6 +34,22 @@ struct key_extractor_identity {
     template <typename T> const auto &operator()(const T &t) const noexcept { return t; }
 };
 
+// NOTE: Seeds are drawn from a per-process random base plus a counter, so tables get distinct
+// seeds without touching std::random_device on every construction.
+inline std::uint64_t next_hash_seed() noexcept {
+    static const std::uint64_t base = [] {
+        try {
+            std::random_device device;
+            return (std::uint64_t{device()} << 32) ^ device();
+        } catch (...) {
+            return std::uint64_t{0x2545F4914F6CDD1Dull};
+        }
+    }();
+    static std::atomic<std::uint64_t> counter{0};
+
+    return mix_hash(base + counter.fetch_add(0x9E3779B97F4A7C15ull, std::memory_order_relaxed));
+}
+
 // TODO:
 //  - Clean up method orders, imports, etc.
 //  - Allocator aware
@@ -43,27 +69,108 @@ public:
     using const_iterator = detail::node_iterator<value_type, true>;
     using local_iterator = detail::local_node_iterator<value_type, is_set>;
     using const_local_iterator = detail::local_node_iterator<value_type, true>;
+    using bucket_range = detail::bucket_range<detail::bucket_node_iterator<value_type, is_set>>;
+    using const_bucket_range = detail::bucket_range<detail::bucket_node_iterator<value_type, true>>;
+    using hashed_key_type = mystd::hashed_key<key_type, Hash>;
 
 private:
     using _return_type = std::conditional_t<Unique, std::pair<iterator, bool>, iterator>;
     using _node_type = detail::node<V>;
+    using _bucket_type = detail::node_bucket<V>;
+
+    // NOTE: Tables of up to _small_size_threshold elements use the inline _single_bucket, so a
+    // default-constructed table allocates nothing and lookups are a linear scan of the list
+    // which compares cached hashes before keys. The bucket array is allocated on growth past it.
+    static constexpr size_type _small_size_threshold = 8;
+    static constexpr size_type _initial_bucket_count = 16;
+
+    // NOTE: for_each_parallel() hands each thread several bucket ranges from a shared counter, so
+    // threads which draw sparse ranges pick up the slack from those which draw dense ones.
+    static constexpr size_type _ranges_per_thread = 8;
+
+    // NOTE: In multi tables with ordered keys, a bucket whose chain holds more than
+    // _treeify_threshold distinct keys is indexed by a sorted array of the first node of each
+    // key's run, so lookups in it are a binary search over (hash, key) rather than a scan. The
+    // index is dropped once fewer than _untreeify_threshold distinct keys remain. Unique tables
+    // only index a bucket once more than _treeify_threshold of its keys share a full hash, which
+    // no seed can separate (see _defend_chain()).
+    static constexpr bool _treeifies = std::totally_ordered<key_type>;
+    static constexpr size_type _treeify_threshold = 8;
+    static constexpr size_type _untreeify_threshold = 4;
+
+    using _group_index = mystd::vector<_node_type *>;
+
+    using _key_traits = detail::key_traits<key_type>;
+    static constexpr bool _has_prefix =
+        _key_traits::has_prefix && std::is_same_v<typename detail::node_key<V>::type, key_type>;
 
     size_type _element_count{};
-    size_type _bucket_count{};
+    size_type _bucket_count{1};
     _node_type _before_begin{};
-    _node_type **_buckets{};
+    _bucket_type _single_bucket{};
+    _bucket_type *_buckets{&_single_bucket};
+    // Sorted by bucket, with an entry for each bucket that is indexed().
+    mystd::vector<std::pair<size_type, _group_index>> _groups;
     float _max_load_factor{0.75};
+    std::uint64_t _seed{detail::next_hash_seed()};
 
     Hash _hash{};
     KeyExtractor _extract_key{};
 
 public:
-    hashtable() : hashtable(16) {}
-    hashtable(size_type count) : _bucket_count(count), _buckets(new _node_type *[count] {}) {}
+    hashtable() = default;
+    hashtable(size_type count)
+        : _bucket_count(std::bit_ceil(std::max(count, size_type{1}))),
+          _buckets(_allocate_buckets(_bucket_count)) {}
+
+    // NOTE: Copies clone the node list in order and keep each node's cached hash, so the bucket
+    // array is sized once and rebuilt directly without hashing or comparing any keys.
+    hashtable(const hashtable &other)
+        : _bucket_count(other._bucket_count), _buckets(_allocate_buckets(other._bucket_count)),
+          _max_load_factor(other._max_load_factor), _seed(other._seed), _hash(other._hash),
+          _extract_key(other._extract_key) {
+        try {
+            _copy_nodes(other);
+        } catch (...) {
+            clear();
+            _deallocate_buckets(_buckets);
+            throw;
+        }
+    }
+
+    hashtable(hashtable &&other) noexcept
+        : _max_load_factor(other._max_load_factor), _seed(other._seed), _hash(other._hash),
+          _extract_key(other._extract_key) {
+        _steal(other);
+    }
 
     ~hashtable() {
         clear();
-        delete[] _buckets;
+        _deallocate_buckets(_buckets);
+    }
+
+    hashtable &operator=(const hashtable &other) {
+        if (this != &other) {
+            hashtable temp(other);
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    hashtable &operator=(hashtable &&other) noexcept {
+        if (this != &other) {
+            clear();
+            _deallocate_buckets(_buckets);
+
+            _max_load_factor = other._max_load_factor;
+            _seed = other._seed;
+            _hash = other._hash;
+            _extract_key = other._extract_key;
+            _steal(other);
+        }
+
+        return *this;
     }
 
     // Iterators.
@@ -81,35 +188,34 @@ public:
     size_type max_size() const noexcept { return std::numeric_limits<size_type>::max(); }
 
     // Modifiers.
-    template <typename... Args> _return_type emplace(Args &&...args) {
+    template <typename... Args>
+        requires(!detail::starts_with_hashed_key<Args...>)
+    _return_type emplace(Args &&...args) {
         value_type data(mystd::forward<Args>(args)...);
-        const key_type &key = _extract_key(data);
+        size_type hash = _hash_of(_extract_key(data));
+
+        return _emplace(hash, mystd::move(data));
+    }
 
+    // NOTE: The element is only constructed if the key is not already present in a unique table.
+    template <typename... Args> _return_type emplace(const hashed_key_type &hk, Args &&...args) {
         if constexpr (Unique) {
-            if (auto existing = find(key); existing != end()) {
-                return {existing, false};
+            if (_node_type *existing = _find_node(hk.key, _mix(hk.hash))) {
+                return {iterator(existing), false};
             }
         }
 
-        auto inserted = _insert_unconditional(new _node_type{
-            .hash = _hash(key),
-            .data = mystd::move(data),
-        });
-
-        if (load_factor() > max_load_factor()) {
-            rehash(2 * bucket_count());
-        }
-
-        if constexpr (Unique) {
-            return {inserted, true};
-        } else {
-            return inserted;
-        }
+        return _emplace(_mix(hk.hash), value_type(hk.key, mystd::forward<Args>(args)...));
     }
 
     _return_type insert(const value_type &value) { return emplace(value); }
     _return_type insert(value_type &&value) { return emplace(std::move(value)); }
 
+    // Inserts value without hashing its key again. hk must be the hashed key of value.
+    _return_type insert(const hashed_key_type &hk, value_type &&value) {
+        return _emplace(_mix(hk.hash), mystd::move(value));
+    }
+
     template <mystd::input_iterator I> void insert(I first, I last) {
         for (; first != last; ++first) {
             insert(*first);
@@ -122,13 +228,21 @@ public:
         _node_type *prev = _get_previous(to_delete);
 
         size_type bucket = _bucket(to_delete);
-        size_type next_bucket = to_delete->next ? _bucket(to_delete->next) : bucket;
+        if constexpr (_treeifies) {
+            if (_buckets[bucket].indexed()) {
+                _remove_group_head(bucket, to_delete);
+            }
+        }
 
-        if (next_bucket != bucket) {
-            _buckets[next_bucket] = prev;
+        bool ends_bucket = !to_delete->next || _bucket(to_delete->next) != bucket;
 
-            if (prev == _buckets[bucket]) {
-                _buckets[bucket] = nullptr;
+        if (ends_bucket) {
+            if (to_delete->next) {
+                _buckets[_bucket(to_delete->next)].before = prev;
+            }
+
+            if (prev == _buckets[bucket].before) {
+                _buckets[bucket].before = nullptr;
             }
         }
 
@@ -136,6 +250,8 @@ public:
         delete to_delete;
         --_element_count;
 
+        _retag(bucket);
+
         return iterator(prev->next);
     }
 
@@ -153,24 +269,8 @@ public:
         return iterator(last.node());
     }
 
-    size_type erase(const key_type &key) {
-        if constexpr (Unique) {
-            auto it = find(key);
-            if (it == end()) {
-                return 0;
-            }
-            erase(it);
-            return 1;
-        } else {
-            auto [first, last] = equal_range(key);
-            size_type count = 0;
-            while (first != last) {
-                first = erase(first);
-                ++count;
-            }
-            return count;
-        }
-    }
+    size_type erase(const key_type &key) { return _erase(key, _hash_of(key)); }
+    size_type erase(const hashed_key_type &hk) { return _erase(hk.key, _mix(hk.hash)); }
 
     void clear() noexcept {
         _node_type *cur = _before_begin.next;
@@ -180,21 +280,33 @@ public:
             cur = next;
         }
 
-        mystd::fill(_buckets, _buckets + bucket_count(), nullptr);
+        mystd::fill(_buckets, _buckets + bucket_count(), _bucket_type{});
+        _groups.clear();
         _before_begin.next = nullptr;
+        _element_count = 0;
     }
 
     void swap(hashtable &other) noexcept {
         mystd::swap(_element_count, other._element_count);
         mystd::swap(_bucket_count, other._bucket_count);
         mystd::swap(_before_begin.next, other._before_begin.next);
+        mystd::swap(_single_bucket, other._single_bucket);
         mystd::swap(_buckets, other._buckets);
+        _groups.swap(other._groups);
         mystd::swap(_max_load_factor, other._max_load_factor);
+        mystd::swap(_seed, other._seed);
         mystd::swap(_hash, other._hash);
         mystd::swap(_extract_key, other._extract_key);
 
-        _buckets[_bucket(_before_begin.next)] = &_before_begin;
-        other._buckets[other._bucket(other._before_begin.next)] = &other._before_begin;
+        if (_buckets == &other._single_bucket) {
+            _buckets = &_single_bucket;
+        }
+        if (other._buckets == &_single_bucket) {
+            other._buckets = &other._single_bucket;
+        }
+
+        _relink_before_begin();
+        other._relink_before_begin();
     }
 
     template <typename H, bool U> void merge(hashtable<V, KeyExtractor, H, U> &other) {
@@ -202,110 +314,196 @@ public:
         while (cur) {
             _node_type *next = cur->next;
 
+            if (!std::is_same_v<H, Hash> || other._seed != _seed) {
+                cur->hash = _hash_of(_extract_key(cur->data));
+            }
+
             if constexpr (Unique) {
-                if (contains(_extract_key(cur->data))) {
+                if (_find_node(_extract_key(cur->data), cur->hash)) {
                     delete cur;
                 } else {
                     _insert_unconditional(cur);
+                    _grow_if_needed();
+                    _defend_chain(cur);
                 }
             } else {
                 _insert_unconditional(cur);
+                _grow_if_needed();
+                _defend_chain(cur);
             }
 
             cur = next;
         }
 
+        mystd::fill(other._buckets, other._buckets + other.bucket_count(), _bucket_type{});
+        other._groups.clear();
         other._before_begin.next = nullptr;
         other._element_count = 0;
     }
 
     // Lookup.
-    iterator find(const key_type &key) noexcept {
-        size_type bucket = this->bucket(key);
-
-        for (auto it = begin(bucket); it != end(bucket); ++it) {
-            if (_extract_key(*it) == key) {
-                return iterator(it.node());
-            }
-        }
-
-        return end();
+    iterator find(const key_type &key) noexcept { return iterator(_find_node(key, _hash_of(key))); }
+    iterator find(const hashed_key_type &hk) noexcept {
+        return iterator(_find_node(hk.key, _mix(hk.hash)));
     }
 
     const_iterator find(const key_type &key) const noexcept {
         return const_cast<hashtable *>(this)->find(key);
     }
+    const_iterator find(const hashed_key_type &hk) const noexcept {
+        return const_cast<hashtable *>(this)->find(hk);
+    }
 
     bool contains(const key_type &key) const noexcept { return find(key) != end(); }
+    bool contains(const hashed_key_type &hk) const noexcept { return find(hk) != end(); }
 
-    size_type count(const key_type &key) const noexcept {
-        if constexpr (Unique) {
-            return find(key) != end() ? 1 : 0;
-        } else {
-            auto [first, last] = equal_range(key);
-            return mystd::distance(first, last);
-        }
+    size_type count(const key_type &key) const noexcept { return _count(key, _hash_of(key)); }
+    size_type count(const hashed_key_type &hk) const noexcept {
+        return _count(hk.key, _mix(hk.hash));
     }
 
     std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
-        if constexpr (Unique) {
-            auto first = find(key);
-            auto second = (first == end()) ? end() : mystd::next(first);
-
-            return {first, second};
-        } else {
-            size_type bucket = this->bucket(key);
-            auto pred = [&](const auto &elem) { return _extract_key(elem) == key; };
-
-            local_iterator bucket_first = mystd::find_if(begin(bucket), end(bucket), pred);
-
-            iterator first = iterator(bucket_first.node());
-            iterator last = mystd::find_if_not(first, end(), pred);
-
-            return {first, last};
-        }
+        return _equal_range(key, _hash_of(key));
+    }
+    std::pair<iterator, iterator> equal_range(const hashed_key_type &hk) noexcept {
+        return _equal_range(hk.key, _mix(hk.hash));
     }
 
     std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const noexcept {
         auto [first, last] = const_cast<hashtable *>(this)->equal_range(key);
         return {first, last};
     }
+    std::pair<const_iterator, const_iterator>
+    equal_range(const hashed_key_type &hk) const noexcept {
+        auto [first, last] = const_cast<hashtable *>(this)->equal_range(hk);
+        return {first, last};
+    }
 
     // Buckets.
     local_iterator begin(size_type bucket) noexcept {
-        _node_type *bucket_start = _buckets[bucket] ? _buckets[bucket]->next : nullptr;
-        return local_iterator(bucket_start, bucket, bucket_count());
+        _node_type *before = _buckets[bucket].before;
+        _node_type *bucket_start = before ? before->next : nullptr;
+        return local_iterator(bucket_start, bucket, _mask());
     }
     const_local_iterator begin(size_type bucket) const noexcept {
-        _node_type *bucket_start = _buckets[bucket] ? _buckets[bucket]->next : nullptr;
-        return const_local_iterator(bucket_start, bucket, bucket_count());
+        _node_type *before = _buckets[bucket].before;
+        _node_type *bucket_start = before ? before->next : nullptr;
+        return const_local_iterator(bucket_start, bucket, _mask());
     }
     const_local_iterator cbegin(size_type bucket) const noexcept { return begin(bucket); }
 
     local_iterator end(size_type bucket) noexcept {
-        return local_iterator(nullptr, bucket, bucket_count());
+        return local_iterator(nullptr, bucket, _mask());
     }
     const_local_iterator end(size_type bucket) const noexcept {
-        return const_local_iterator(nullptr, bucket, bucket_count());
+        return const_local_iterator(nullptr, bucket, _mask());
     }
     const_local_iterator cend(size_type bucket) const noexcept { return end(bucket); }
 
     size_type bucket_count() const noexcept { return _bucket_count; }
     size_type max_bucket_count() const noexcept { return std::numeric_limits<size_type>::max(); }
-    size_type bucket(const key_type &key) const noexcept { return _hash(key) % bucket_count(); }
+    size_type bucket(const key_type &key) const noexcept { return _hash_of(key) & _mask(); }
+    size_type bucket(const hashed_key_type &hk) const noexcept {
+        return _mix(hk.hash) & _mask();
+    }
     size_type bucket_size(size_type bucket) const noexcept {
         return mystd::distance(begin(bucket), end(bucket));
     }
 
+    // Parallel iteration.
+    // NOTE: Splits the buckets into up to count contiguous ranges of near-equal bucket counts.
+    // The ranges visit disjoint elements, so each may be walked on its own thread while the table
+    // is not being modified.
+    mystd::vector<bucket_range> bucket_ranges(size_type count) {
+        return _bucket_ranges<bucket_range>(count);
+    }
+    mystd::vector<const_bucket_range> bucket_ranges(size_type count) const {
+        return _bucket_ranges<const_bucket_range>(count);
+    }
+
+    // Calls fn(element) for every element on up to `threads` threads, in no particular order.
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) {
+        _for_each_parallel(bucket_ranges(threads * _ranges_per_thread), fn, threads);
+    }
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) const {
+        _for_each_parallel(bucket_ranges(threads * _ranges_per_thread), fn, threads);
+    }
+
     // Hashing.
-    float load_factor() const noexcept { return size() / bucket_count(); }
+    float load_factor() const noexcept { return static_cast<float>(size()) / bucket_count(); }
     float max_load_factor() const noexcept { return _max_load_factor; }
     void max_load_factor(float ml) noexcept { _max_load_factor = ml; }
+    std::uint64_t seed() const noexcept { return _seed; }
 
+    // NOTE: Bucket counts are rounded up to a power of two, so a bucket index is a mask of the
+    // (seeded and mixed) hash rather than a division.
     void rehash(size_type count) {
-        size_type new_bucket_count =
-            std::max(count, static_cast<size_type>(std::ceil(size() / max_load_factor())));
-        _node_type **new_buckets = new _node_type *[new_bucket_count] {};
+        size_type new_bucket_count = std::bit_ceil(std::max(
+            {count, static_cast<size_type>(std::ceil(size() / max_load_factor())), size_type{1}}));
+        _relink(_allocate_buckets(new_bucket_count), new_bucket_count);
+    }
+
+    void reserve(size_type count) {
+        if (_is_small() && count <= _small_size_threshold) {
+            return;
+        }
+
+        rehash(static_cast<size_type>(std::ceil(count / max_load_factor())));
+    }
+
+    // NOTE: Reserves for the number of distinct keys in [first, last), estimated by a HyperLogLog
+    // pass over their hashes, so a bulk load of a duplicate-heavy range rehashes at most once.
+    // The range is traversed here and again by the load, so it must be a forward range.
+    template <mystd::forward_iterator I> void reserve_estimated(I first, I last) {
+        reserve(detail::estimate_distinct_keys<key_type>(first, last, _hash, _extract_key));
+    }
+
+private:
+    iterator _insert_unconditional(_node_type *node) noexcept {
+        size_type bucket = _bucket(node);
+
+        if (_buckets[bucket].before) {
+            if constexpr (Unique) {
+                node->next = _buckets[bucket].before->next;
+                _buckets[bucket].before->next = node;
+                _buckets[bucket].push_front(_bucket_type::tag(node->hash));
+                _add_group_head(bucket, node);
+            } else {
+                auto [first, last] = _equal_range(_extract_key(node->data), node->hash);
+                _node_type *insert_after =
+                    (first != last) ? first.node() : _buckets[bucket].before;
+
+                node->next = insert_after->next;
+                insert_after->next = node;
+
+                if (node->next && _bucket(node->next) != bucket) {
+                    _buckets[_bucket(node->next)].before = node;
+                }
+                _retag(bucket);
+
+                if (first == last) {
+                    _add_group_head(bucket, node);
+                }
+            }
+        } else {
+            node->next = _before_begin.next;
+            _before_begin.next = node;
+
+            if (node->next) {
+                _buckets[_bucket(node->next)].before = node;
+            }
+            _buckets[bucket].before = &_before_begin;
+            _buckets[bucket].push_front(_bucket_type::tag(node->hash));
+        }
+
+        ++_element_count;
+        return iterator(node);
+    }
+
+    // Relinks every node into a new bucket array using the cached hashes.
+    void _relink(_bucket_type *new_buckets, size_type new_bucket_count) noexcept {
+        bool had_groups = !_groups.empty();
+        _groups.clear();
 
         _node_type *cur = _before_begin.next;
         _before_begin.next = nullptr;
@@ -316,64 +514,371 @@ public:
         while (cur) {
             _node_type *next = cur->next;
 
-            size_type bucket = cur->hash % new_bucket_count;
+            size_type bucket = cur->hash & (new_bucket_count - 1);
 
-            if (new_buckets[bucket]) {
-                cur->next = new_buckets[bucket]->next;
-                new_buckets[bucket]->next = cur;
+            if (new_buckets[bucket].before) {
+                cur->next = new_buckets[bucket].before->next;
+                new_buckets[bucket].before->next = cur;
             } else {
                 cur->next = _before_begin.next;
                 _before_begin.next = cur;
 
                 if (cur->next) {
-                    new_buckets[cur->next->hash % new_bucket_count] = cur;
+                    new_buckets[cur->next->hash & (new_bucket_count - 1)].before = cur;
                 }
-                new_buckets[bucket] = &_before_begin;
+                new_buckets[bucket].before = &_before_begin;
             }
 
             cur = next;
         }
 
-        delete[] _buckets;
+        for (cur = _before_begin.next; cur; cur = cur->next) {
+            new_buckets[cur->hash & (new_bucket_count - 1)].push_back(
+                _bucket_type::tag(cur->hash));
+        }
+
+        if (_buckets != new_buckets) {
+            _deallocate_buckets(_buckets);
+        }
         _buckets = new_buckets;
         _bucket_count = new_bucket_count;
+
+        if (had_groups) {
+            _treeify_all();
+        }
     }
 
-    void reserve(size_type count) {
-        rehash(static_cast<size_type>(std::ceil(count / max_load_factor())));
+    // NOTE: Past the tagged prefix, a chain is scanned for nodes whose hash differs from the one
+    // just inserted. Under a random seed, more than a few times the load factor of them is
+    // vanishingly unlikely and is taken as a sign of keys crafted against the current seed, so
+    // the table reseeds and rehashes. Equal hashes can't be separated by reseeding (e.g. strings
+    // crafted against the unseeded std::hash), so a unique table indexes a bucket holding more
+    // than _treeify_threshold of them instead. The scan stops as soon as either is decided, and
+    // indexed buckets are not scanned at all, so inserting into a long chain stays cheap.
+    void _defend_chain(_node_type *inserted) {
+        size_type bucket = _bucket(inserted);
+        if (!_buckets[bucket].overflows() || _buckets[bucket].indexed()) {
+            return;
+        }
+
+        constexpr bool indexes_equal_hashes = Unique && _treeifies;
+        size_type limit = std::max(size_type{16}, static_cast<size_type>(4 * max_load_factor()));
+        size_type others = 0;
+        size_type equal = 0;
+
+        for (_node_type *node = _buckets[bucket].before->next; node && _bucket(node) == bucket;
+             node = node->next) {
+            if (node->hash != inserted->hash) {
+                if (++others > limit) {
+                    _reseed();
+                    return;
+                }
+            } else if (indexes_equal_hashes && ++equal > _treeify_threshold) {
+                _treeify(bucket);
+                return;
+            }
+        }
     }
 
-private:
-    iterator _insert_unconditional(_node_type *node) noexcept {
-        size_type bucket = _bucket(node);
+    void _reseed() {
+        _bucket_type *new_buckets = _allocate_buckets(bucket_count());
 
-        if (_buckets[bucket]) {
-            _node_type *insert_after;
-            if constexpr (Unique) {
-                insert_after = _buckets[bucket];
-            } else {
-                auto [first, last] = equal_range(_extract_key(node->data));
-                insert_after = (first != last) ? first.node() : _buckets[bucket];
+        _seed = detail::next_hash_seed();
+        for (_node_type *node = _before_begin.next; node; node = node->next) {
+            node->hash = _hash_of(_extract_key(node->data));
+        }
+
+        _relink(new_buckets, bucket_count());
+    }
+
+    size_type _mix(size_type hash) const noexcept { return detail::mix_hash(hash ^ _seed); }
+    size_type _hash_of(const key_type &key) const noexcept { return _mix(_hash(key)); }
+
+    _return_type _emplace(size_type hash, value_type &&data) {
+        if constexpr (Unique) {
+            if (_node_type *existing = _find_node(_extract_key(data), hash)) {
+                return {iterator(existing), false};
             }
+        }
+
+        auto *node = new _node_type{
+            .hash = hash,
+            .data = mystd::move(data),
+        };
+        if constexpr (_has_prefix) {
+            node->prefix = _key_traits::prefix(_extract_key(node->data));
+        }
+
+        auto inserted = _insert_unconditional(node);
+        _grow_if_needed();
+        _defend_chain(inserted.node());
 
-            node->next = insert_after->next;
-            insert_after->next = node;
+        if constexpr (Unique) {
+            return {inserted, true};
         } else {
-            node->next = _before_begin.next;
-            _before_begin.next = node;
+            return inserted;
+        }
+    }
 
-            if (node->next) {
-                _buckets[_bucket(node->next)] = node;
+    size_type _erase(const key_type &key, size_type hash) {
+        if constexpr (Unique) {
+            _node_type *node = _find_node(key, hash);
+            if (!node) {
+                return 0;
             }
-            _buckets[bucket] = &_before_begin;
+            erase(const_iterator(node));
+            return 1;
+        } else {
+            auto [first, last] = _equal_range(key, hash);
+            size_type count = 0;
+            while (first != last) {
+                first = erase(first);
+                ++count;
+            }
+            return count;
         }
+    }
 
-        ++_element_count;
-        return iterator(node);
+    size_type _count(const key_type &key, size_type hash) const noexcept {
+        if constexpr (Unique) {
+            return _find_node(key, hash) ? 1 : 0;
+        } else {
+            auto [first, last] = const_cast<hashtable *>(this)->_equal_range(key, hash);
+            return mystd::distance(first, last);
+        }
+    }
+
+    std::pair<iterator, iterator> _equal_range(const key_type &key, size_type hash) noexcept {
+        iterator first(_find_node(key, hash));
+
+        if constexpr (Unique) {
+            return {first, first == end() ? end() : mystd::next(first)};
+        } else {
+            auto pred = [&](const auto &elem) { return _extract_key(elem) == key; };
+            return {first, mystd::find_if_not(first, end(), pred)};
+        }
+    }
+
+    // NOTE: Only nodes whose tag matches are dereferenced within the tagged prefix of the chain,
+    // and a miss in a chain no longer than the prefix touches no nodes at all.
+    _node_type *_find_node(const key_type &key, size_type hash) const noexcept {
+        size_type index = hash & _mask();
+        const _bucket_type &bucket = _buckets[index];
+
+        if (!bucket.before) {
+            return nullptr;
+        }
+
+        if constexpr (_treeifies) {
+            if (bucket.indexed()) {
+                const _group_index &groups = _group_index_of(index);
+                auto it = _group_lower_bound(groups, key, hash);
+
+                bool found = it != groups.end() && (*it)->hash == hash &&
+                             _extract_key((*it)->data) == key;
+                return found ? *it : nullptr;
+            }
+        }
+
+        std::uint64_t matches = bucket.match(_bucket_type::tag(hash));
+        if (!matches && !bucket.overflows()) {
+            return nullptr;
+        }
+
+        auto is_match = [&, prefix = _prefix_of(key)](const _node_type *node) {
+            if (node->hash != hash) {
+                return false;
+            }
+
+            if constexpr (_has_prefix) {
+                if (!_key_traits::equal(node->prefix, prefix)) {
+                    return false;
+                }
+                if (_key_traits::decisive(prefix)) {
+                    return true;
+                }
+            }
+
+            return _extract_key(node->data) == key;
+        };
+
+        _node_type *node = bucket.before->next;
+        size_type position = 0;
+
+        for (; matches; matches &= matches - 1) {
+            for (size_type target = std::countr_zero(matches) / 8; position < target; ++position) {
+                node = node->next;
+            }
+
+            if (is_match(node)) {
+                return node;
+            }
+        }
+
+        if (!bucket.overflows()) {
+            return nullptr;
+        }
+
+        for (; position < bucket.tag_count(); ++position) {
+            node = node->next;
+        }
+        for (; node && (node->hash & _mask()) == index; node = node->next) {
+            if (is_match(node)) {
+                return node;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static auto _prefix_of(const key_type &key) noexcept {
+        if constexpr (_has_prefix) {
+            return _key_traits::prefix(key);
+        } else {
+            return detail::no_key_prefix{};
+        }
+    }
+
+    // Rebuilds a bucket's tags from its chain after an insertion or erasure in the middle of it.
+    void _retag(size_type bucket) noexcept {
+        _bucket_type &b = _buckets[bucket];
+        b.clear_tags();
+
+        if (b.before) {
+            for (_node_type *node = b.before->next; node && _bucket(node) == bucket;
+                 node = node->next) {
+                b.push_back(_bucket_type::tag(node->hash));
+                if (b.overflows()) {
+                    break;
+                }
+            }
+        }
+    }
+
+    // Treeified buckets.
+    const _group_index &_group_index_of(size_type bucket) const noexcept {
+        auto it = std::partition_point(_groups.begin(), _groups.end(),
+                                       [&](const auto &entry) { return entry.first < bucket; });
+        return it->second;
+    }
+
+    _group_index &_group_index_of(size_type bucket) noexcept {
+        return const_cast<_group_index &>(std::as_const(*this)._group_index_of(bucket));
+    }
+
+    template <typename Groups>
+    auto _group_lower_bound(Groups &groups, const key_type &key, size_type hash) const noexcept {
+        return std::partition_point(groups.begin(), groups.end(), [&](const _node_type *node) {
+            return node->hash != hash ? node->hash < hash : _extract_key(node->data) < key;
+        });
+    }
+
+    size_type _count_groups(size_type bucket) const noexcept {
+        size_type count = 0;
+        const _node_type *prev = nullptr;
+
+        for (_node_type *node = _buckets[bucket].before->next; node && _bucket(node) == bucket;
+             node = node->next) {
+            if (!prev || prev->hash != node->hash ||
+                !(_extract_key(prev->data) == _extract_key(node->data))) {
+                ++count;
+            }
+            prev = node;
+        }
+
+        return count;
+    }
+
+    // Builds the index of a bucket's run heads. On allocation failure the bucket stays a chain.
+    void _treeify(size_type bucket) noexcept {
+        try {
+            _group_index groups;
+            const _node_type *prev = nullptr;
+
+            for (_node_type *node = _buckets[bucket].before->next;
+                 node && _bucket(node) == bucket; node = node->next) {
+                if (!prev || prev->hash != node->hash ||
+                    !(_extract_key(prev->data) == _extract_key(node->data))) {
+                    groups.push_back(node);
+                }
+                prev = node;
+            }
+
+            std::sort(groups.begin(), groups.end(), [&](const _node_type *a, const _node_type *b) {
+                return a->hash != b->hash ? a->hash < b->hash
+                                          : _extract_key(a->data) < _extract_key(b->data);
+            });
+
+            auto pos = std::partition_point(_groups.begin(), _groups.end(), [&](const auto &entry) {
+                return entry.first < bucket;
+            });
+            _groups.insert(pos, {bucket, mystd::move(groups)});
+            _buckets[bucket].set_indexed(true);
+        } catch (...) {
+        }
+    }
+
+    void _untreeify(size_type bucket) noexcept {
+        auto it = std::partition_point(_groups.begin(), _groups.end(),
+                                       [&](const auto &entry) { return entry.first < bucket; });
+        _groups.erase(it);
+        _buckets[bucket].set_indexed(false);
+    }
+
+    void _treeify_all() noexcept {
+        for (_node_type *node = _before_begin.next; node;) {
+            size_type bucket = _bucket(node);
+            if (_count_groups(bucket) > _treeify_threshold) {
+                _treeify(bucket);
+            }
+
+            while (node && _bucket(node) == bucket) {
+                node = node->next;
+            }
+        }
+    }
+
+    // Called once a node starting a new run of equal keys is linked into the bucket.
+    void _add_group_head(size_type bucket, _node_type *node) noexcept {
+        if constexpr (_treeifies) {
+            if (_buckets[bucket].indexed()) {
+                _group_index &groups = _group_index_of(bucket);
+                try {
+                    groups.insert(_group_lower_bound(groups, _extract_key(node->data), node->hash),
+                                  node);
+                } catch (...) {
+                    _untreeify(bucket);
+                }
+            } else if (!Unique && _buckets[bucket].overflows() &&
+                       _count_groups(bucket) > _treeify_threshold) {
+                _treeify(bucket);
+            }
+        }
+    }
+
+    // Called before a node is unlinked from an indexed bucket.
+    void _remove_group_head(size_type bucket, _node_type *node) noexcept {
+        const key_type &key = _extract_key(node->data);
+        _group_index &groups = _group_index_of(bucket);
+
+        auto it = _group_lower_bound(groups, key, node->hash);
+        if (it == groups.end() || *it != node) {
+            return;
+        }
+
+        _node_type *next = node->next;
+        if (next && next->hash == node->hash && _extract_key(next->data) == key) {
+            *it = next;
+        } else {
+            groups.erase(it);
+            if (groups.size() < _untreeify_threshold) {
+                _untreeify(bucket);
+            }
+        }
     }
 
     _node_type *_get_previous(_node_type *node) {
-        _node_type *prev = _buckets[_bucket(node)];
+        _node_type *prev = _buckets[_bucket(node)].before;
         while (prev && prev->next != node) {
             prev = prev->next;
         }
@@ -381,7 +886,108 @@ private:
         return prev;
     }
 
-    size_type _bucket(_node_type *node) { return node->hash % bucket_count(); }
+    size_type _mask() const noexcept { return bucket_count() - 1; }
+
+    template <typename Range> mystd::vector<Range> _bucket_ranges(size_type count) const {
+        using range_iterator = typename Range::iterator;
+
+        count = std::clamp(count, size_type{1}, bucket_count());
+        mystd::vector<Range> ranges;
+        ranges.reserve(count);
+
+        for (size_type i = 0; i < count; ++i) {
+            size_type first = i * bucket_count() / count;
+            size_type last = (i + 1) * bucket_count() / count;
+            ranges.push_back({range_iterator(_buckets, first, last, _mask()), range_iterator()});
+        }
+
+        return ranges;
+    }
+
+    template <typename Ranges, typename Fn>
+    static void _for_each_parallel(const Ranges &ranges, Fn &fn, size_type threads) {
+        detail::for_each_partition(ranges.size(), threads, [&](size_type r) {
+            for (auto &value : ranges[r]) {
+                fn(value);
+            }
+        });
+    }
+    size_type _bucket(const _node_type *node) const noexcept { return node->hash & _mask(); }
+
+    bool _is_small() const noexcept { return _buckets == &_single_bucket; }
+
+    void _copy_nodes(const hashtable &other) {
+        _node_type *tail = &_before_begin;
+
+        for (const _node_type *cur = other._before_begin.next; cur; cur = cur->next) {
+            tail->next =
+                new _node_type{.hash = cur->hash, .prefix = cur->prefix, .data = cur->data};
+
+            size_type bucket = _bucket(tail->next);
+            if (!_buckets[bucket].before) {
+                _buckets[bucket].before = tail;
+            }
+            _buckets[bucket].push_back(_bucket_type::tag(cur->hash));
+
+            tail = tail->next;
+            ++_element_count;
+        }
+
+        if (!other._groups.empty()) {
+            _treeify_all();
+        }
+    }
+
+    // Takes ownership of other's nodes and buckets, leaving it as an empty small table.
+    void _steal(hashtable &other) noexcept {
+        _element_count = mystd::exchange(other._element_count, 0);
+        _bucket_count = mystd::exchange(other._bucket_count, 1);
+        _before_begin.next = mystd::exchange(other._before_begin.next, nullptr);
+
+        if (other._is_small()) {
+            _single_bucket = other._single_bucket;
+            _buckets = &_single_bucket;
+        } else {
+            _buckets = other._buckets;
+        }
+
+        other._single_bucket = _bucket_type{};
+        other._buckets = &other._single_bucket;
+        _groups.swap(other._groups);
+
+        _relink_before_begin();
+    }
+
+    void _grow_if_needed() {
+        if (_is_small()) {
+            if (size() > _small_size_threshold) {
+                rehash(_initial_bucket_count);
+            }
+        } else if (load_factor() > max_load_factor()) {
+            rehash(2 * bucket_count());
+        }
+    }
+
+    _bucket_type *_allocate_buckets(size_type count) {
+        if (count <= 1) {
+            _single_bucket = _bucket_type{};
+            return &_single_bucket;
+        }
+
+        return new _bucket_type[count]{};
+    }
+
+    void _deallocate_buckets(_bucket_type *buckets) noexcept {
+        if (buckets != &_single_bucket) {
+            delete[] buckets;
+        }
+    }
+
+    void _relink_before_begin() noexcept {
+        if (_before_begin.next) {
+            _buckets[_bucket(_before_begin.next)].before = &_before_begin;
+        }
+    }
 };
 
 } // namespace mystd::detail
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "bits/iterator_base_types.hpp"
+#include "bits/key_traits.hpp"
 
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 
@@ -11,9 +15,79 @@ namespace mystd::detail {
 template <typename T> struct node {
     node *next{};
     std::size_t hash{};
+    [[no_unique_address]] node_key_prefix_t<T> prefix{};
     T data{};
 };
 
+// NOTE: A bucket points at the node *before* its first node (see detail::hashtable), and carries
+// 8-bit tags derived from the hashes of its first tag_capacity nodes. The tags share an 8-byte
+// word with the tag count, so a lookup can compare them all at once and skip non-matching nodes
+// without dereferencing them.
+template <typename T> struct node_bucket {
+    static constexpr std::size_t tag_capacity = 7;
+    static constexpr std::uint8_t overflow_bit = 0x80;
+    static constexpr std::uint8_t indexed_bit = 0x40;
+
+    node<T> *before{};
+    // The final byte holds the tag count, with overflow_bit set if the chain is longer and
+    // indexed_bit set if the hashtable keeps a sorted index of the chain (see _treeify()).
+    std::uint8_t tags[tag_capacity + 1]{};
+
+    static std::uint8_t tag(std::size_t hash) noexcept {
+        return static_cast<std::uint8_t>((hash * 0x9E3779B97F4A7C15ull) >> 56);
+    }
+
+    std::size_t tag_count() const noexcept {
+        return tags[tag_capacity] & ~(overflow_bit | indexed_bit);
+    }
+    bool overflows() const noexcept { return tags[tag_capacity] & overflow_bit; }
+    bool indexed() const noexcept { return tags[tag_capacity] & indexed_bit; }
+
+    void set_indexed(bool indexed) noexcept {
+        tags[tag_capacity] = indexed ? (tags[tag_capacity] | indexed_bit)
+                                     : (tags[tag_capacity] & ~indexed_bit);
+    }
+
+    // Returns a mask with the high bit of byte i set iff tags[i] == tag, for i < tag_count().
+    std::uint64_t match(std::uint8_t tag) const noexcept {
+        constexpr std::uint64_t lows = 0x0101010101010101ull;
+        constexpr std::uint64_t sevens = 0x7F7F7F7F7F7F7F7Full;
+
+        std::uint64_t word;
+        std::memcpy(&word, tags, sizeof(word));
+        if constexpr (std::endian::native == std::endian::big) {
+            word = __builtin_bswap64(word);
+        }
+
+        std::uint64_t diff = word ^ (lows * tag);
+        std::uint64_t zero_bytes = ~(((diff & sevens) + sevens) | diff | sevens);
+
+        return zero_bytes & ((std::uint64_t{1} << (8 * tag_count())) - 1);
+    }
+
+    void push_front(std::uint8_t tag) noexcept {
+        if (tag_count() == tag_capacity) {
+            tags[tag_capacity] |= overflow_bit;
+        } else {
+            ++tags[tag_capacity];
+        }
+
+        std::memmove(tags + 1, tags, tag_capacity - 1);
+        tags[0] = tag;
+    }
+
+    void push_back(std::uint8_t tag) noexcept {
+        if (tag_count() == tag_capacity) {
+            tags[tag_capacity] |= overflow_bit;
+        } else {
+            tags[tag_count()] = tag;
+            ++tags[tag_capacity];
+        }
+    }
+
+    void clear_tags() noexcept { tags[tag_capacity] &= indexed_bit; }
+};
+
 template <typename T, bool IsConst = false> class node_iterator {
     template <typename U, bool OtherConst> friend class node_iterator;
 
@@ -60,7 +134,7 @@ template <typename T, bool IsConst = false> class local_node_iterator {
 
     struct node<T> *_node{};
     std::size_t _bucket{};
-    std::size_t _bucket_count{};
+    std::size_t _mask{};
 
 public:
     using iterator_category = mystd::forward_iterator_tag;
@@ -70,17 +144,18 @@ public:
     using difference_type = std::ptrdiff_t;
 
     local_node_iterator() = default;
-    explicit local_node_iterator(struct node<T> *node, std::size_t bucket, std::size_t bucket_count)
-        : _node(node), _bucket(bucket), _bucket_count(bucket_count) {}
+    // NOTE: Bucket counts are powers of two, so mask is bucket_count - 1.
+    explicit local_node_iterator(struct node<T> *node, std::size_t bucket, std::size_t mask)
+        : _node(node), _bucket(bucket), _mask(mask) {}
 
     template <bool OtherConst>
     explicit local_node_iterator(const local_node_iterator<T, OtherConst> &other)
         requires(IsConst || !OtherConst)
-        : _node(other._node), _bucket(other._bucket), _bucket_count(other._bucket_count) {}
+        : _node(other._node), _bucket(other._bucket), _mask(other._mask) {}
 
     local_node_iterator &operator++() noexcept {
         _node = _node->next;
-        if (_node && _node->hash % _bucket_count != _bucket) {
+        if (_node && (_node->hash & _mask) != _bucket) {
             _node = nullptr;
         }
 
@@ -105,4 +180,83 @@ public:
     }
 };
 
+// Walks the nodes of buckets [first, last) one bucket at a time, so iterators over disjoint bucket
+// ranges visit disjoint elements and may run concurrently. The end iterator is default-constructed.
+template <typename T, bool IsConst = false> class bucket_node_iterator {
+    template <typename U, bool OtherConst> friend class bucket_node_iterator;
+
+    const node_bucket<T> *_buckets{};
+    struct node<T> *_node{};
+    std::size_t _bucket{};
+    std::size_t _last{};
+    std::size_t _mask{};
+
+public:
+    using iterator_category = mystd::forward_iterator_tag;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+
+    bucket_node_iterator() = default;
+    bucket_node_iterator(const node_bucket<T> *buckets, std::size_t first, std::size_t last,
+                         std::size_t mask)
+        : _buckets(buckets), _bucket(first), _last(last), _mask(mask) {
+        _seek();
+    }
+
+    template <bool OtherConst>
+    bucket_node_iterator(const bucket_node_iterator<T, OtherConst> &other)
+        requires(IsConst || !OtherConst)
+        : _buckets(other._buckets), _node(other._node), _bucket(other._bucket),
+          _last(other._last), _mask(other._mask) {}
+
+    bucket_node_iterator &operator++() noexcept {
+        _node = _node->next;
+        if (!_node || (_node->hash & _mask) != _bucket) {
+            ++_bucket;
+            _seek();
+        }
+
+        return *this;
+    }
+
+    bucket_node_iterator operator++(int) noexcept {
+        bucket_node_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    reference operator*() const noexcept { return _node->data; }
+    pointer operator->() const noexcept { return std::addressof(_node->data); }
+
+    template <bool OtherConst>
+    friend bool operator==(const bucket_node_iterator &lhs,
+                           const bucket_node_iterator<T, OtherConst> &rhs) {
+        return lhs._node == rhs._node;
+    }
+
+private:
+    // Moves to the first node of the first non-empty bucket in [_bucket, _last).
+    void _seek() noexcept {
+        for (_node = nullptr; _bucket < _last; ++_bucket) {
+            if (_buckets[_bucket].before) {
+                _node = _buckets[_bucket].before->next;
+                return;
+            }
+        }
+    }
+};
+
+// A disjoint slice of a table, as handed out by bucket_ranges().
+template <typename It> struct bucket_range {
+    using iterator = It;
+
+    It first;
+    It last;
+
+    It begin() const noexcept { return first; }
+    It end() const noexcept { return last; }
+};
+
 } // namespace mystd::detail
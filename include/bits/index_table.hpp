@@ -0,0 +1,317 @@
+#pragma once
+
+#include "bits/hashtable.hpp"
+#include "bits/iterator_concepts.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mystd::detail {
+
+// An open-addressed (linear probing) table of 32-bit entry indices. It never touches keys itself:
+// lookups take an equality predicate over entry indices, and relocation takes a function mapping
+// an entry index to its stored hash, so growth never rehashes keys.
+class slot_index {
+public:
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+    static constexpr size_type max_entries = npos - 1;
+
+private:
+    static constexpr size_type _min_slot_count = 8;
+
+    // 0 marks an empty slot, otherwise the slot holds (entry index + 1).
+    mystd::vector<index_type> _slots;
+    unsigned _shift{};
+
+public:
+    size_type slot_count() const noexcept { return _slots.size(); }
+
+    // NOTE: Keeps the load factor at or below one half.
+    bool needs_growth(size_type entry_count) const noexcept {
+        return 2 * (entry_count + 1) > slot_count();
+    }
+
+    template <typename Eq> index_type find(size_type hash, Eq eq) const {
+        if (_slots.empty()) {
+            return npos;
+        }
+
+        for (size_type slot = _home(hash);; slot = _next(slot)) {
+            index_type value = _slots[slot];
+            if (value == 0) {
+                return npos;
+            }
+            if (eq(value - 1)) {
+                return value - 1;
+            }
+        }
+    }
+
+    void insert(size_type hash, index_type index) noexcept {
+        size_type slot = _home(hash);
+        while (_slots[slot] != 0) {
+            slot = _next(slot);
+        }
+
+        _slots[slot] = index + 1;
+    }
+
+    void replace(size_type hash, index_type old_index, index_type new_index) noexcept {
+        _slots[_slot_of(hash, old_index)] = new_index + 1;
+    }
+
+    // Backward-shift deletion, so no tombstones are left behind.
+    template <typename HashOf> void erase(size_type hash, index_type index, HashOf hash_of) {
+        size_type hole = _slot_of(hash, index);
+
+        for (size_type slot = _next(hole); _slots[slot] != 0; slot = _next(slot)) {
+            size_type home = _home(hash_of(_slots[slot] - 1));
+
+            bool stays = (hole <= slot) ? (hole < home && home <= slot)
+                                        : (hole < home || home <= slot);
+            if (!stays) {
+                _slots[hole] = _slots[slot];
+                hole = slot;
+            }
+        }
+
+        _slots[hole] = 0;
+    }
+
+    // Renumbers every index above the given one after an order-preserving erase.
+    void shift_down(index_type erased) noexcept {
+        for (auto &value : _slots) {
+            if (value > erased + 1) {
+                --value;
+            }
+        }
+    }
+
+    template <typename HashOf>
+    void rebuild(size_type entry_count, size_type min_entries, HashOf hash_of) {
+        size_type count = _min_slot_count;
+        while (count < 2 * (std::max(entry_count, min_entries) + 1)) {
+            count *= 2;
+        }
+
+        mystd::vector<index_type> slots(count);
+        _slots.swap(slots);
+        _shift = std::numeric_limits<size_type>::digits - std::countr_zero(count);
+
+        for (size_type i = 0; i < entry_count; ++i) {
+            insert(hash_of(i), static_cast<index_type>(i));
+        }
+    }
+
+    void clear() noexcept { mystd::fill(_slots.begin(), _slots.end(), index_type{0}); }
+
+    void swap(slot_index &other) noexcept {
+        _slots.swap(other._slots);
+        mystd::swap(_shift, other._shift);
+    }
+
+private:
+    // NOTE: Fibonacci hashing, so weak hashes (e.g. the identity std::hash<int>) still spread.
+    size_type _home(size_type hash) const noexcept {
+        return (hash * 11400714819323198485ull) >> _shift;
+    }
+
+    size_type _next(size_type slot) const noexcept { return (slot + 1) & (slot_count() - 1); }
+
+    size_type _slot_of(size_type hash, index_type index) const noexcept {
+        size_type slot = _home(hash);
+        while (_slots[slot] != index + 1) {
+            slot = _next(slot);
+        }
+
+        return slot;
+    }
+};
+
+// NOTE: Values are stored densely in insertion order, with their hashes in a parallel vector, so
+// iteration is a linear scan over plain pointers. erase() swap-removes with the last element,
+// which invalidates iterators to it; shift_erase() preserves order at O(n) cost.
+template <typename V, typename KeyExtractor, typename Hash> class index_table {
+    static constexpr bool is_set = std::is_same_v<KeyExtractor, key_extractor_identity>;
+
+public:
+    using value_type = V;
+    using key_type =
+        std::remove_cvref_t<decltype(std::declval<KeyExtractor>()(std::declval<value_type>()))>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = std::conditional_t<is_set, const value_type *, value_type *>;
+    using const_iterator = const value_type *;
+
+private:
+    using _index_type = slot_index::index_type;
+
+    mystd::vector<value_type> _values;
+    mystd::vector<size_type> _hashes;
+    slot_index _index;
+
+    Hash _hash{};
+    KeyExtractor _extract_key{};
+
+public:
+    index_table() = default;
+
+    // Iterators.
+    iterator begin() noexcept { return _values.begin(); }
+    const_iterator begin() const noexcept { return _values.begin(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return _values.end(); }
+    const_iterator end() const noexcept { return _values.end(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Capacity.
+    bool empty() const noexcept { return _values.empty(); }
+    size_type size() const noexcept { return _values.size(); }
+    size_type max_size() const noexcept { return slot_index::max_entries; }
+
+    void reserve(size_type count) {
+        _values.reserve(count);
+        _hashes.reserve(count);
+
+        if (_index.needs_growth(count)) {
+            _index.rebuild(size(), count, [this](size_type i) { return _hashes[i]; });
+        }
+    }
+
+    // Modifiers.
+    template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+        value_type data(mystd::forward<Args>(args)...);
+        size_type hash = _hash(_extract_key(data));
+
+        if (auto index = _find(_extract_key(data), hash); index != slot_index::npos) {
+            return {begin() + index, false};
+        }
+
+        if (size() >= max_size()) {
+            throw std::length_error("mystd::detail::index_table::emplace() exceeded max_size().");
+        }
+        if (_index.needs_growth(size())) {
+            _index.rebuild(size(), size() + 1, [this](size_type i) { return _hashes[i]; });
+        }
+
+        _values.push_back(mystd::move(data));
+        try {
+            _hashes.push_back(hash);
+        } catch (...) {
+            _values.pop_back();
+            throw;
+        }
+
+        _index.insert(hash, static_cast<_index_type>(size() - 1));
+        return {end() - 1, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value) { return emplace(value); }
+    std::pair<iterator, bool> insert(value_type &&value) { return emplace(mystd::move(value)); }
+
+    template <mystd::input_iterator I> void insert(I first, I last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+    void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+
+    iterator erase(const_iterator pos) {
+        auto index = static_cast<_index_type>(pos - cbegin());
+        auto last = static_cast<_index_type>(size() - 1);
+
+        _index.erase(_hashes[index], index, [this](size_type i) { return _hashes[i]; });
+
+        if (index != last) {
+            _values[index] = mystd::move(_values[last]);
+            _hashes[index] = _hashes[last];
+            _index.replace(_hashes[last], last, index);
+        }
+
+        _values.pop_back();
+        _hashes.pop_back();
+
+        return begin() + index;
+    }
+
+    size_type erase(const key_type &key) {
+        auto it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+
+        erase(it);
+        return 1;
+    }
+
+    iterator shift_erase(const_iterator pos) {
+        auto index = static_cast<_index_type>(pos - cbegin());
+
+        _index.erase(_hashes[index], index, [this](size_type i) { return _hashes[i]; });
+        _index.shift_down(index);
+
+        _values.erase(_values.begin() + index);
+        _hashes.erase(_hashes.begin() + index);
+
+        return begin() + index;
+    }
+
+    size_type shift_erase(const key_type &key) {
+        auto it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+
+        shift_erase(it);
+        return 1;
+    }
+
+    void clear() noexcept {
+        _values.clear();
+        _hashes.clear();
+        _index.clear();
+    }
+
+    void swap(index_table &other) noexcept {
+        _values.swap(other._values);
+        _hashes.swap(other._hashes);
+        _index.swap(other._index);
+        mystd::swap(_hash, other._hash);
+        mystd::swap(_extract_key, other._extract_key);
+    }
+
+    // Lookup.
+    iterator find(const key_type &key) noexcept {
+        auto index = _find(key, _hash(key));
+        return index == slot_index::npos ? end() : begin() + index;
+    }
+
+    const_iterator find(const key_type &key) const noexcept {
+        return const_cast<index_table *>(this)->find(key);
+    }
+
+    bool contains(const key_type &key) const noexcept { return find(key) != end(); }
+    size_type count(const key_type &key) const noexcept { return contains(key) ? 1 : 0; }
+
+private:
+    _index_type _find(const key_type &key, size_type hash) const noexcept {
+        return _index.find(hash, [&](_index_type i) {
+            return _hashes[i] == hash && _extract_key(_values[i]) == key;
+        });
+    }
+};
+
+} // namespace mystd::detail
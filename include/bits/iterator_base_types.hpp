@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <type_traits>
 
 namespace mystd {
 
@@ -8,6 +10,7 @@ struct input_iterator_tag {};
 struct forward_iterator_tag : input_iterator_tag {};
 struct bidirectional_iterator_tag : forward_iterator_tag {};
 struct random_access_iterator_tag : bidirectional_iterator_tag {};
+struct contiguous_iterator_tag : random_access_iterator_tag {};
 
 template <typename Category, typename T, typename Distance = std::ptrdiff_t, typename Pointer = T *,
           typename Reference = T &>
@@ -27,7 +30,10 @@ template <typename I> struct iterator_traits {
     using difference_type = typename I::difference_type;
 };
 
+// NOTE: As with std::iterator_traits, pointers keep random_access_iterator_tag as their category
+// for existing code dispatching on it, and advertise contiguity through iterator_concept.
 template <typename T> struct iterator_traits<T *> {
+    using iterator_concept = contiguous_iterator_tag;
     using iterator_category = random_access_iterator_tag;
     using value_type = T;
     using pointer = T *;
@@ -36,6 +42,7 @@ template <typename T> struct iterator_traits<T *> {
 };
 
 template <typename T> struct iterator_traits<const T *> {
+    using iterator_concept = contiguous_iterator_tag;
     using iterator_category = random_access_iterator_tag;
     using value_type = T;
     using pointer = const T *;
@@ -43,4 +50,32 @@ template <typename T> struct iterator_traits<const T *> {
     using difference_type = std::ptrdiff_t;
 };
 
+// Iterators other than pointers opt in to contiguity by declaring an iterator_concept.
+template <typename I> struct iterator_concept {
+    using type = typename iterator_traits<I>::iterator_category;
+};
+template <typename I>
+    requires requires { typename I::iterator_concept; }
+struct iterator_concept<I> {
+    using type = typename I::iterator_concept;
+};
+template <typename T> struct iterator_concept<T *> {
+    using type = typename iterator_traits<T *>::iterator_concept;
+};
+template <typename I> using iterator_concept_t = typename iterator_concept<I>::type;
+
+// Obtains the address a pointer or pointer-like object refers to, without dereferencing it.
+template <typename T> constexpr T *to_address(T *p) noexcept {
+    static_assert(!std::is_function_v<T>);
+    return p;
+}
+
+template <typename P> constexpr auto to_address(const P &p) noexcept {
+    if constexpr (requires { std::pointer_traits<P>::to_address(p); }) {
+        return std::pointer_traits<P>::to_address(p);
+    } else {
+        return mystd::to_address(p.operator->());
+    }
+}
+
 } // namespace mystd
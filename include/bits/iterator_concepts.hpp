@@ -130,6 +130,23 @@ concept random_access_iterator =
     } &&
     std::derived_from<typename mystd::iterator_traits<I>::iterator_category, mystd::random_access_iterator_tag>;
 
+/**
+ * [semantics]
+ * - elements are stored adjacently in memory: for dereferenceable a and n with a + n
+ *   dereferenceable, to_address(a + n) == to_address(a) + n
+ */
+template <typename I>
+concept contiguous_iterator =
+    random_access_iterator<I> &&
+    std::derived_from<mystd::iterator_concept_t<I>, mystd::contiguous_iterator_tag> &&
+    std::is_lvalue_reference_v<typename mystd::iterator_traits<I>::reference> &&
+    std::same_as<typename mystd::iterator_traits<I>::value_type,
+                 std::remove_cvref_t<typename mystd::iterator_traits<I>::reference>> &&
+    requires(const I &i) {
+        { mystd::to_address(i) } ->
+            std::same_as<std::add_pointer_t<typename mystd::iterator_traits<I>::reference>>;
+    };
+
 // clang-format on
 
 } // namespace mystd
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mystd {
+
+namespace detail {
+
+// The 64-bit finaliser from MurmurHash3, a bijection that spreads every input bit over the output.
+inline std::uint64_t mix_hash(std::uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+struct no_key_prefix {};
+
+// NOTE: Describes how the hashtable may speed up comparisons of a key type. has_prefix keys
+// store prefix(key) inline in their node next to the cached hash, and a lookup compares the
+// prefixes before touching the key itself. Where decisive(prefix) holds, equal prefixes mean
+// equal keys and the key is never touched.
+template <typename K> struct key_traits {
+    using prefix_type = no_key_prefix;
+    static constexpr bool has_prefix = false;
+};
+
+// The key's length (saturated at 16) followed by its first 15 bytes, zero padded.
+struct short_key_prefix {
+    alignas(16) unsigned char bytes[16];
+};
+
+template <> struct key_traits<std::string> {
+    using prefix_type = short_key_prefix;
+    static constexpr bool has_prefix = true;
+    static constexpr std::size_t inline_size = sizeof(prefix_type) - 1;
+
+    static prefix_type prefix(std::string_view key) noexcept {
+        prefix_type p{};
+        std::size_t size = std::min(key.size(), inline_size);
+
+        p.bytes[0] = static_cast<unsigned char>(key.size() > inline_size ? 16 : key.size());
+        std::memcpy(p.bytes + 1, key.data(), size);
+        return p;
+    }
+
+    static bool equal(const prefix_type &a, const prefix_type &b) noexcept {
+#if defined(__SSE2__)
+        __m128i x = _mm_load_si128(reinterpret_cast<const __m128i *>(a.bytes));
+        __m128i y = _mm_load_si128(reinterpret_cast<const __m128i *>(b.bytes));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xFFFF;
+#else
+        return std::memcmp(a.bytes, b.bytes, sizeof(a.bytes)) == 0;
+#endif
+    }
+
+    static bool decisive(const prefix_type &p) noexcept { return p.bytes[0] <= inline_size; }
+};
+
+// The key held by a node<T>: T itself, or the first member of a map's pair.
+template <typename T> struct node_key {
+    using type = T;
+};
+template <typename K, typename V> struct node_key<std::pair<K, V>> {
+    using type = std::remove_const_t<K>;
+};
+
+template <typename T>
+using node_key_prefix_t = typename key_traits<typename node_key<T>::type>::prefix_type;
+
+} // namespace detail
+
+// NOTE: A string hash for short keys. Inputs of up to 16 bytes are read as two (possibly
+// overlapping) words and mixed, rather than hashed a byte at a time; longer inputs fall back to
+// std::hash<std::string_view>.
+struct short_string_hash {
+    std::size_t operator()(std::string_view str) const noexcept {
+        const char *data = str.data();
+        std::size_t size = str.size();
+
+        if (size > 16) {
+            return std::hash<std::string_view>()(str);
+        }
+
+        std::uint64_t lo = 0;
+        std::uint64_t hi = 0;
+        if (size >= 8) {
+            std::memcpy(&lo, data, 8);
+            std::memcpy(&hi, data + size - 8, 8);
+        } else if (size >= 4) {
+            std::uint32_t first;
+            std::uint32_t last;
+            std::memcpy(&first, data, 4);
+            std::memcpy(&last, data + size - 4, 4);
+            lo = first;
+            hi = last;
+        } else if (size > 0) {
+            lo = (std::uint64_t{static_cast<unsigned char>(data[0])} << 16) |
+                 (std::uint64_t{static_cast<unsigned char>(data[size / 2])} << 8) |
+                 static_cast<unsigned char>(data[size - 1]);
+        }
+
+        return detail::mix_hash(lo ^ detail::mix_hash(hi ^ (size * 0x9E3779B97F4A7C15ull)));
+    }
+};
+
+} // namespace mystd
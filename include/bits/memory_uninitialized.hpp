@@ -1,13 +1,26 @@
 #pragma once
 
+#include "algorithm.hpp"
 #include "bits/iterator_base_types.hpp"
 #include "bits/iterator_concepts.hpp"
+#include "type_traits.hpp"
 
+#include <cstddef>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 
 namespace mystd {
 
+namespace detail {
+
+template <typename I, typename O, typename Source>
+concept bitwise_constructible =
+    bitwise_copyable<I, O> &&
+    std::is_trivially_constructible_v<typename mystd::iterator_traits<O>::value_type, Source>;
+
+} // namespace detail
+
 template <mystd::forward_iterator I> void destroy(I first, I last) {
     using T = typename mystd::iterator_traits<I>::value_type;
     static_assert(std::is_destructible_v<T>);
@@ -23,6 +36,10 @@ O uninitialized_copy(I first, I last, O d_first) {
     using U = typename mystd::iterator_traits<I>::value_type;
     static_assert(std::is_constructible_v<T, const U &>);
 
+    if constexpr (detail::bitwise_constructible<I, O, const U &>) {
+        return detail::bitwise_copy(first, last, d_first);
+    }
+
     O current = d_first;
     try {
         for (; first != last; ++first, ++current) {
@@ -41,6 +58,10 @@ O uninitialized_move(I first, I last, O d_first) {
     using U = typename mystd::iterator_traits<I>::value_type;
     static_assert(std::is_constructible_v<T, U &&>);
 
+    if constexpr (detail::bitwise_constructible<I, O, U &&>) {
+        return detail::bitwise_copy(first, last, d_first);
+    }
+
     O current = d_first;
     try {
         for (; first != last; ++first, ++current) {
@@ -53,8 +74,32 @@ O uninitialized_move(I first, I last, O d_first) {
     }
 }
 
+// NOTE: Default-initializes, so trivially default constructible elements are left indeterminate
+// and nothing is written to them. See uninitialized_value_construct() to zero them.
 template <mystd::forward_iterator I> void uninitialized_default_construct(I first, I last) {
     using T = typename mystd::iterator_traits<I>::value_type;
+    if constexpr (std::is_trivially_default_constructible_v<T>) {
+        return;
+    }
+
+    I current = first;
+    try {
+        for (; current != last; current++) {
+            ::new (static_cast<void *>(std::addressof(*current))) T;
+        }
+    } catch (...) {
+        destroy(first, current);
+        throw;
+    }
+}
+
+template <mystd::forward_iterator I> void uninitialized_value_construct(I first, I last) {
+    using T = typename mystd::iterator_traits<I>::value_type;
+    if constexpr (std::is_scalar_v<T>) {
+        if (detail::bitwise_fill(first, last, T())) {
+            return;
+        }
+    }
 
     I current = first;
     try {
@@ -72,6 +117,10 @@ void uninitialized_fill(I first, I last, const T &value) {
     using V = typename mystd::iterator_traits<I>::value_type;
     static_assert(std::is_constructible_v<V, const T &>);
 
+    if (detail::bitwise_fill(first, last, value)) {
+        return;
+    }
+
     I current = first;
     try {
         for (; current != last; current++) {
@@ -83,4 +132,30 @@ void uninitialized_fill(I first, I last, const T &value) {
     }
 }
 
+// NOTE: Moves [first, last) into the uninitialized storage at d_first and ends the lifetime of the
+// originals. Trivially relocatable types are moved with a single memmove, so the ranges may
+// overlap; other types are move-constructed and then destroyed, and the ranges must not overlap.
+template <typename T> T *uninitialized_relocate(T *first, T *last, T *d_first) {
+    if constexpr (mystd::is_trivially_relocatable_v<T>) {
+        if (first == last) {
+            return d_first;
+        }
+
+        std::memmove(static_cast<void *>(d_first), static_cast<const void *>(first),
+                     static_cast<std::size_t>(last - first) * sizeof(T));
+        return d_first + (last - first);
+    } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        // One pass, so that each element is only brought into cache once.
+        for (; first != last; ++first, ++d_first) {
+            ::new (static_cast<void *>(d_first)) T(mystd::move(*first));
+            first->~T();
+        }
+        return d_first;
+    } else {
+        T *d_last = mystd::uninitialized_move(first, last, d_first);
+        mystd::destroy(first, last);
+        return d_last;
+    }
+}
+
 } // namespace mystd
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace mystd::detail {
+
+// Runs fn(p) for every partition, on up to `threads` threads pulling partitions from a shared
+// counter. The first exception thrown stops the remaining partitions and is rethrown.
+template <typename Fn> void for_each_partition(std::size_t partitions, std::size_t threads, Fn fn) {
+    threads = std::clamp(threads, std::size_t{1}, std::max(partitions, std::size_t{1}));
+    if (threads == 1) {
+        for (std::size_t p = 0; p < partitions; ++p) {
+            fn(p);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto worker = [&] {
+        try {
+            for (std::size_t p; (p = next.fetch_add(1)) < partitions;) {
+                fn(p);
+            }
+        } catch (...) {
+            std::lock_guard lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = partitions;
+        }
+    };
+
+    // NOTE: If a thread fails to start, those already running are stopped and joined before the
+    // error propagates, as destroying a joinable std::thread terminates.
+    mystd::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    try {
+        for (std::size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+    } catch (...) {
+        next = partitions;
+        for (auto &thread : pool) {
+            thread.join();
+        }
+        throw;
+    }
+    worker();
+
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace mystd::detail
@@ -0,0 +1,824 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+
+namespace mystd {
+
+template <typename T, typename A> class deque;
+
+namespace detail {
+
+// Blocks span 4 KiB, but hold at least 16 elements so that large types still amortise the cost
+// of allocating one.
+template <typename T>
+inline constexpr std::size_t deque_block_size = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+
+// A position in a deque: an element, the block holding it and the slot of that block in the map.
+// Every position a deque hands out lies in an allocated block, end() included.
+template <typename T, bool IsConst = false> class deque_iterator {
+    template <typename U, bool OtherConst> friend class deque_iterator;
+    template <typename U, typename A> friend class mystd::deque;
+
+    static constexpr std::size_t _block_size = deque_block_size<T>;
+
+    T *_cur{};
+    T *_first{};
+    T *_last{};
+    T **_node{};
+
+public:
+    using iterator_category = mystd::random_access_iterator_tag;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+
+    deque_iterator() = default;
+    template <bool OtherConst>
+    deque_iterator(const deque_iterator<T, OtherConst> &other)
+        requires(IsConst || !OtherConst)
+        : _cur(other._cur), _first(other._first), _last(other._last), _node(other._node) {}
+
+    reference operator*() const noexcept { return *_cur; }
+    pointer operator->() const noexcept { return _cur; }
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    deque_iterator &operator++() noexcept {
+        if (++_cur == _last) {
+            _set_node(_node + 1);
+            _cur = _first;
+        }
+        return *this;
+    }
+
+    deque_iterator operator++(int) noexcept {
+        deque_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    deque_iterator &operator--() noexcept {
+        if (_cur == _first) {
+            _set_node(_node - 1);
+            _cur = _last;
+        }
+        --_cur;
+        return *this;
+    }
+
+    deque_iterator operator--(int) noexcept {
+        deque_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    deque_iterator &operator+=(difference_type n) noexcept {
+        constexpr auto block_size = static_cast<difference_type>(_block_size);
+
+        difference_type offset = n + (_cur - _first);
+        if (offset >= 0 && offset < block_size) {
+            _cur += n;
+        } else {
+            difference_type nodes =
+                offset >= 0 ? offset / block_size : -((-offset - 1) / block_size) - 1;
+            _set_node(_node + nodes);
+            _cur = _first + (offset - nodes * block_size);
+        }
+        return *this;
+    }
+
+    deque_iterator &operator-=(difference_type n) noexcept { return *this += -n; }
+
+    deque_iterator operator+(difference_type n) const noexcept {
+        deque_iterator tmp = *this;
+        return tmp += n;
+    }
+
+    deque_iterator operator-(difference_type n) const noexcept {
+        deque_iterator tmp = *this;
+        return tmp -= n;
+    }
+
+    friend deque_iterator operator+(difference_type n, const deque_iterator &it) noexcept {
+        return it + n;
+    }
+
+    template <bool OtherConst>
+    difference_type operator-(const deque_iterator<T, OtherConst> &other) const noexcept {
+        return static_cast<difference_type>(_block_size) * (_node - other._node) +
+               (_cur - _first) - (other._cur - other._first);
+    }
+
+    template <bool OtherConst>
+    bool operator==(const deque_iterator<T, OtherConst> &other) const noexcept {
+        return _cur == other._cur;
+    }
+
+    template <bool OtherConst>
+    auto operator<=>(const deque_iterator<T, OtherConst> &other) const noexcept {
+        return _node == other._node ? _cur <=> other._cur : _node <=> other._node;
+    }
+
+private:
+    void _set_node(T **node) noexcept {
+        _node = node;
+        _first = *node;
+        _last = _first + _block_size;
+    }
+};
+
+} // namespace detail
+
+// NOTE: Elements live in fixed-size blocks, and a map array holds the blocks in order with room to
+// spare at both ends, so pushing and popping at either end is O(1) and never moves elements.
+// Growing the map only copies block pointers, and re-centres them in place when the map is less
+// than half full, so a queue that drifts through the map does not reallocate it.
+//
+// A block emptied by pop_front() or pop_back() is kept as a spare and reused by the next push that
+// needs one, so a queue whose size holds steady makes no allocator calls. shrink_to_fit() frees
+// the spare.
+template <typename T, typename A = mystd::allocator<T>> class deque {
+public:
+    using value_type = T;
+    using allocator_type = A;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = mystd::allocator_traits<allocator_type>::pointer;
+    using const_pointer = mystd::allocator_traits<allocator_type>::const_pointer;
+    using iterator = detail::deque_iterator<T>;
+    using const_iterator = detail::deque_iterator<T, true>;
+    using reverse_iterator = mystd::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystd::reverse_iterator<const_iterator>;
+
+    static constexpr size_type block_size = detail::deque_block_size<T>;
+
+private:
+    using map_allocator = mystd::allocator<pointer>;
+    using map_pointer = pointer *;
+
+    static constexpr size_type _min_map_size = 8;
+
+    [[no_unique_address]] A _allocator{};
+    [[no_unique_address]] map_allocator _map_allocator{};
+
+    map_pointer _map{};
+    size_type _map_size{};
+    pointer _spare{};
+
+    // Both point into allocated blocks once the map exists; _finish is never at the end of one.
+    iterator _start;
+    iterator _finish;
+
+public:
+    // Construction.
+    deque() noexcept(noexcept(allocator_type())) : deque(allocator_type()) {}
+
+    explicit deque(const allocator_type &allocator) noexcept : _allocator(allocator) {}
+
+    explicit deque(size_type count, const allocator_type &allocator = allocator_type())
+        : deque(allocator) {
+        resize(count);
+    }
+
+    deque(size_type count, const_reference value,
+          const allocator_type &allocator = allocator_type())
+        : deque(allocator) {
+        resize(count, value);
+    }
+
+    // NOTE: The constructors delegating to this one need no cleanup of their own, as the
+    // destructor runs if they throw.
+    template <mystd::input_iterator I>
+    deque(I first, I last, const allocator_type &allocator = allocator_type()) : deque(allocator) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    deque(const deque &other)
+        : deque(other.begin(), other.end(),
+                mystd::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                    other._allocator)) {}
+
+    deque(const deque &other, const allocator_type &allocator)
+        : deque(other.begin(), other.end(), allocator) {}
+
+    deque(deque &&other) noexcept : _allocator(std::move(other._allocator)) {
+        _swap_storage(other);
+    }
+
+    deque(std::initializer_list<value_type> il, const allocator_type &allocator = allocator_type())
+        : deque(il.begin(), il.end(), allocator) {};
+
+    ~deque() { _free(); }
+
+    deque &operator=(const deque &other) {
+        if (this != &other) {
+            if constexpr (mystd::allocator_traits<
+                              allocator_type>::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) {
+                    _free();
+                    _allocator = other._allocator;
+                }
+            }
+
+            assign(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    deque &operator=(deque &&other) {
+        constexpr bool propagate =
+            mystd::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+        if (propagate || _allocator == other._allocator) {
+            mystd::swap(_allocator, other._allocator);
+            _swap_storage(other);
+        } else {
+            clear();
+            for (auto &element : other) {
+                emplace_back(mystd::move(element));
+            }
+        }
+
+        return *this;
+    }
+
+    deque &operator=(std::initializer_list<value_type> il) {
+        assign(il);
+        return *this;
+    }
+
+    // NOTE: Assignment reuses the existing elements and blocks when it can.
+    void assign(size_type count, const_reference value) {
+        iterator it = begin();
+        for (size_type i = 0; i < count; ++i) {
+            if (it == end()) {
+                resize(count, value);
+                return;
+            }
+            *it++ = value;
+        }
+        _erase_at_back(it);
+    }
+
+    template <mystd::input_iterator I> void assign(I first, I last) {
+        iterator it = begin();
+        for (; first != last && it != end(); ++first, ++it) {
+            *it = *first;
+        }
+
+        if (first == last) {
+            _erase_at_back(it);
+            return;
+        }
+
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
+    // Access.
+    reference operator[](size_type pos) noexcept {
+        return _start[static_cast<difference_type>(pos)];
+    }
+    const_reference operator[](size_type pos) const noexcept {
+        return _start[static_cast<difference_type>(pos)];
+    }
+
+    reference front() noexcept { return *_start; }
+    const_reference front() const noexcept { return *_start; }
+
+    reference back() noexcept { return *(_finish - 1); }
+    const_reference back() const noexcept { return *(_finish - 1); }
+
+    reference at(size_type pos) {
+        if (pos >= size()) {
+            throw std::out_of_range("mystd::deque::at() was called with an index out of bounds.");
+        }
+        return (*this)[pos];
+    }
+    const_reference at(size_type pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range("mystd::deque::at() was called with an index out of bounds.");
+        }
+        return (*this)[pos];
+    }
+
+    allocator_type get_allocator() const noexcept { return _allocator; }
+
+    // Iterators.
+    iterator begin() noexcept { return _start; }
+    const_iterator begin() const noexcept { return _start; }
+    const_iterator cbegin() const noexcept { return _start; }
+
+    iterator end() noexcept { return _finish; }
+    const_iterator end() const noexcept { return _finish; }
+    const_iterator cend() const noexcept { return _finish; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+    // Capacity.
+    bool empty() const noexcept { return _start == _finish; }
+    size_type size() const noexcept { return static_cast<size_type>(_finish - _start); }
+    size_type max_size() const noexcept {
+        return std::numeric_limits<difference_type>::max() / sizeof(T);
+    }
+
+    // Frees the spare block, and the map too if the deque is empty.
+    void shrink_to_fit() noexcept {
+        if (empty()) {
+            _free();
+            return;
+        }
+
+        if (_spare) {
+            mystd::allocator_traits<allocator_type>::deallocate(_allocator, _spare, block_size);
+            _spare = nullptr;
+        }
+    }
+
+    // Modifiers.
+    void clear() noexcept {
+        if (_map) {
+            _erase_at_back(_start);
+            _start._cur = _finish._cur = _start._first + block_size / 2;
+        }
+    }
+
+    // NOTE: The arguments may refer to elements, which is safe as pushing never moves elements.
+    template <typename... Args> reference emplace_back(Args &&...args) {
+        if (_finish._last - _finish._cur > 1) [[likely]] {
+            mystd::allocator_traits<allocator_type>::construct(_allocator, _finish._cur,
+                                                               mystd::forward<Args>(args)...);
+            return *_finish._cur++;
+        }
+
+        return _emplace_back_block(mystd::forward<Args>(args)...);
+    }
+
+    template <typename... Args> reference emplace_front(Args &&...args) {
+        if (_start._cur != _start._first) [[likely]] {
+            mystd::allocator_traits<allocator_type>::construct(_allocator, _start._cur - 1,
+                                                               mystd::forward<Args>(args)...);
+            return *--_start._cur;
+        }
+
+        return _emplace_front_block(mystd::forward<Args>(args)...);
+    }
+
+    void push_back(const_reference value) { emplace_back(value); }
+    void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+    void push_front(const_reference value) { emplace_front(value); }
+    void push_front(value_type &&value) { emplace_front(std::move(value)); }
+
+    void pop_back() noexcept {
+        if (_finish._cur == _finish._first) {
+            _release_block(_finish._first);
+            _finish._set_node(_finish._node - 1);
+            _finish._cur = _finish._last;
+        }
+        --_finish._cur;
+        mystd::allocator_traits<allocator_type>::destroy(_allocator, _finish._cur);
+    }
+
+    void pop_front() noexcept {
+        mystd::allocator_traits<allocator_type>::destroy(_allocator, _start._cur);
+        if (++_start._cur == _start._last) {
+            _release_block(_start._first);
+            _start._set_node(_start._node + 1);
+            _start._cur = _start._first;
+        }
+    }
+
+    // NOTE: Inserting in the middle shifts the elements on whichever side of pos is shorter.
+    template <typename... Args> iterator emplace(const_iterator pos, Args &&...args) {
+        size_type index = static_cast<size_type>(pos - cbegin());
+        size_type count = size();
+
+        if (index == 0) {
+            emplace_front(mystd::forward<Args>(args)...);
+            return begin();
+        }
+
+        if (index == count) {
+            emplace_back(mystd::forward<Args>(args)...);
+            return end() - 1;
+        }
+
+        // The arguments may refer to an element that is about to be shifted.
+        value_type value(mystd::forward<Args>(args)...);
+
+        if (index < count / 2) {
+            emplace_front(mystd::move(front()));
+            mystd::move(begin() + 2, begin() + index + 1, begin() + 1);
+        } else {
+            emplace_back(mystd::move(back()));
+            mystd::move_backward(begin() + index, begin() + count - 1, begin() + count);
+        }
+
+        iterator result = begin() + index;
+        *result = mystd::move(value);
+        return result;
+    }
+
+    iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type count, const_reference value) {
+        size_type index = static_cast<size_type>(pos - cbegin());
+        size_type old_size = size();
+
+        if (index < old_size / 2) {
+            _insert_at_front(index, [&] {
+                for (size_type i = 0; i < count; ++i) {
+                    emplace_front(value);
+                }
+            });
+        } else {
+            _insert_at_back(index, [&] {
+                for (size_type i = 0; i < count; ++i) {
+                    emplace_back(value);
+                }
+            });
+        }
+
+        return begin() + index;
+    }
+
+    template <mystd::input_iterator I> iterator insert(const_iterator pos, I first, I last) {
+        size_type index = static_cast<size_type>(pos - cbegin());
+        size_type old_size = size();
+
+        if (mystd::forward_iterator<I> && index < old_size / 2) {
+            _insert_at_front(index, [&] {
+                for (; first != last; ++first) {
+                    emplace_front(*first);
+                }
+
+                // The elements went in back to front.
+                for (iterator lo = begin(), hi = begin() + (size() - old_size); lo < hi;) {
+                    mystd::swap(*lo++, *--hi);
+                }
+            });
+        } else {
+            _insert_at_back(index, [&] {
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            });
+        }
+
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+        return insert(pos, il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    // NOTE: Erasing in the middle shifts the elements on whichever side of the gap is shorter.
+    iterator erase(const_iterator first, const_iterator last) {
+        size_type index = static_cast<size_type>(first - cbegin());
+        size_type count = static_cast<size_type>(last - first);
+        if (count == 0) {
+            return begin() + index;
+        }
+
+        iterator gap = begin() + index;
+
+        if (index < size() - index - count) {
+            mystd::move_backward(begin(), gap, gap + count);
+            _erase_at_front(begin() + count);
+        } else {
+            mystd::move(gap + count, end(), gap);
+            _erase_at_back(end() - count);
+        }
+
+        return begin() + index;
+    }
+
+    void resize(size_type count, const_reference value) {
+        if (count < size()) {
+            _erase_at_back(begin() + count);
+            return;
+        }
+
+        while (size() < count) {
+            emplace_back(value);
+        }
+    }
+
+    void resize(size_type count) {
+        if (count < size()) {
+            _erase_at_back(begin() + count);
+            return;
+        }
+
+        while (size() < count) {
+            emplace_back();
+        }
+    }
+
+    // NOTE: It is UB to call swap() on containers with different allocators.
+    void swap(deque &other) noexcept {
+        if constexpr (mystd::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+            mystd::swap(_allocator, other._allocator);
+        }
+
+        _swap_storage(other);
+    }
+
+private:
+    void _swap_storage(deque &other) noexcept {
+        mystd::swap(_map, other._map);
+        mystd::swap(_map_size, other._map_size);
+        mystd::swap(_spare, other._spare);
+        mystd::swap(_start, other._start);
+        mystd::swap(_finish, other._finish);
+    }
+
+    pointer _allocate_block() {
+        if (_spare) {
+            return mystd::exchange(_spare, nullptr);
+        }
+        return mystd::allocator_traits<allocator_type>::allocate(_allocator, block_size);
+    }
+
+    // Keeps the block as the spare, or frees it if there already is one.
+    void _release_block(pointer block) noexcept {
+        if (!_spare) {
+            _spare = block;
+        } else {
+            mystd::allocator_traits<allocator_type>::deallocate(_allocator, block, block_size);
+        }
+    }
+
+    // Allocates a map with a single block, starting in the middle of the block so that pushes at
+    // either end fill it.
+    void _initialize_map() {
+        map_pointer map = mystd::allocator_traits<map_allocator>::allocate(_map_allocator,
+                                                                           _min_map_size);
+        try {
+            map[_min_map_size / 2] = _allocate_block();
+        } catch (...) {
+            mystd::allocator_traits<map_allocator>::deallocate(_map_allocator, map, _min_map_size);
+            throw;
+        }
+
+        _map = map;
+        _map_size = _min_map_size;
+        _start._set_node(_map + _min_map_size / 2);
+        _start._cur = _start._first + block_size / 2;
+        _finish = _start;
+    }
+
+    // Makes room in the map for nodes_to_add more blocks at the front or back, re-centring the
+    // blocks in place if that leaves the map at most half full and reallocating it otherwise.
+    void _reserve_map(size_type nodes_to_add, bool at_front) {
+        size_type old_nodes = static_cast<size_type>(_finish._node - _start._node) + 1;
+        size_type new_nodes = old_nodes + nodes_to_add;
+
+        map_pointer new_start;
+        if (_map_size > 2 * new_nodes) {
+            new_start = _map + (_map_size - new_nodes) / 2 + (at_front ? nodes_to_add : 0);
+            std::memmove(new_start, _start._node, old_nodes * sizeof(pointer));
+        } else {
+            size_type new_map_size = _map_size + std::max(_map_size, nodes_to_add) + 2;
+            map_pointer new_map = mystd::allocator_traits<map_allocator>::allocate(
+                _map_allocator, new_map_size);
+
+            new_start = new_map + (new_map_size - new_nodes) / 2 + (at_front ? nodes_to_add : 0);
+            std::memcpy(new_start, _start._node, old_nodes * sizeof(pointer));
+            mystd::allocator_traits<map_allocator>::deallocate(_map_allocator, _map, _map_size);
+
+            _map = new_map;
+            _map_size = new_map_size;
+        }
+
+        _start._set_node(new_start);
+        _finish._set_node(new_start + old_nodes - 1);
+    }
+
+    // The slow path of emplace_back(), run when the element fills the last block. A block is added
+    // behind it so that _finish stays inside a block.
+    template <typename... Args> [[gnu::noinline]] reference _emplace_back_block(Args &&...args) {
+        if (!_map) {
+            _initialize_map();
+            return emplace_back(mystd::forward<Args>(args)...);
+        }
+
+        if (static_cast<size_type>(_finish._node - _map) + 2 > _map_size) {
+            _reserve_map(1, false);
+        }
+
+        _finish._node[1] = _allocate_block();
+        try {
+            mystd::allocator_traits<allocator_type>::construct(_allocator, _finish._cur,
+                                                               mystd::forward<Args>(args)...);
+        } catch (...) {
+            _release_block(_finish._node[1]);
+            throw;
+        }
+
+        pointer element = _finish._cur;
+        _finish._set_node(_finish._node + 1);
+        _finish._cur = _finish._first;
+        return *element;
+    }
+
+    // The slow path of emplace_front(), run when the first block has no room in front.
+    template <typename... Args> [[gnu::noinline]] reference _emplace_front_block(Args &&...args) {
+        if (!_map) {
+            _initialize_map();
+            return emplace_front(mystd::forward<Args>(args)...);
+        }
+
+        if (_start._node == _map) {
+            _reserve_map(1, true);
+        }
+
+        _start._node[-1] = _allocate_block();
+        try {
+            mystd::allocator_traits<allocator_type>::construct(
+                _allocator, _start._node[-1] + block_size - 1, mystd::forward<Args>(args)...);
+        } catch (...) {
+            _release_block(_start._node[-1]);
+            throw;
+        }
+
+        _start._set_node(_start._node - 1);
+        _start._cur = _start._last - 1;
+        return *_start._cur;
+    }
+
+    // Inserts at index by running add, which pushes the new elements at the back, then rotating
+    // them into place. Elements already pushed are removed if add throws.
+    template <typename Add> void _insert_at_back(size_type index, Add add) {
+        size_type old_size = size();
+        try {
+            add();
+        } catch (...) {
+            _erase_at_back(begin() + old_size);
+            throw;
+        }
+        _rotate(begin() + index, begin() + old_size, end());
+    }
+
+    // Inserts at index by running add, which pushes the new elements at the front in order, then
+    // rotating them into place.
+    template <typename Add> void _insert_at_front(size_type index, Add add) {
+        size_type old_size = size();
+        try {
+            add();
+        } catch (...) {
+            _erase_at_front(end() - old_size);
+            throw;
+        }
+
+        size_type added = size() - old_size;
+        _rotate(begin(), begin() + added, begin() + added + index);
+    }
+
+    static void _rotate(iterator first, iterator middle, iterator last) {
+        if (first == middle || middle == last) {
+            return;
+        }
+
+        iterator next = middle;
+        while (first != next) {
+            mystd::swap(*first++, *next++);
+            if (next == last) {
+                next = middle;
+            } else if (first == middle) {
+                middle = next;
+            }
+        }
+    }
+
+    // Destroys the elements of [first, last) a block at a time.
+    void _destroy(iterator first, iterator last) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            if (first._node == last._node) {
+                mystd::destroy(first._cur, last._cur);
+                return;
+            }
+
+            mystd::destroy(first._cur, first._last);
+            for (map_pointer node = first._node + 1; node < last._node; ++node) {
+                mystd::destroy(*node, *node + block_size);
+            }
+            mystd::destroy(last._first, last._cur);
+        }
+    }
+
+    // Removes the elements before new_start and releases the blocks they leave empty.
+    void _erase_at_front(iterator new_start) noexcept {
+        _destroy(_start, new_start);
+        for (map_pointer node = _start._node; node < new_start._node; ++node) {
+            _release_block(*node);
+        }
+        _start = new_start;
+    }
+
+    // Removes the elements from new_finish on and releases the blocks they leave empty.
+    void _erase_at_back(iterator new_finish) noexcept {
+        _destroy(new_finish, _finish);
+        for (map_pointer node = new_finish._node + 1; node <= _finish._node; ++node) {
+            _release_block(*node);
+        }
+        _finish = new_finish;
+    }
+
+    // Destroys the elements and frees the blocks, the spare and the map.
+    void _free() noexcept {
+        if (_map) {
+            _destroy(_start, _finish);
+            for (map_pointer node = _start._node; node <= _finish._node; ++node) {
+                mystd::allocator_traits<allocator_type>::deallocate(_allocator, *node, block_size);
+            }
+            mystd::allocator_traits<map_allocator>::deallocate(_map_allocator, _map, _map_size);
+        }
+
+        if (_spare) {
+            mystd::allocator_traits<allocator_type>::deallocate(_allocator, _spare, block_size);
+        }
+
+        _map = nullptr;
+        _map_size = 0;
+        _spare = nullptr;
+        _start = _finish = iterator();
+    }
+};
+
+template <typename T, typename A>
+struct is_trivially_relocatable<deque<T, A>> : is_trivially_relocatable<A> {};
+
+template <typename T, typename A>
+auto operator<=>(const deque<T, A> &lhs, const deque<T, A> &rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename A> bool operator==(const deque<T, A> &lhs, const deque<T, A> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    return (lhs <=> rhs) == 0;
+}
+
+template <typename T, typename A> void swap(deque<T, A> &a, deque<T, A> &b) noexcept {
+    a.swap(b);
+}
+
+// Removes the elements for which pred returns true, keeping the order of the rest, and returns how
+// many were removed.
+template <typename T, typename A, typename Pred>
+typename deque<T, A>::size_type erase_if(deque<T, A> &c, Pred pred) {
+    auto out = mystd::find_if(c.begin(), c.end(), pred);
+    if (out == c.end()) {
+        return 0;
+    }
+
+    for (auto it = out + 1; it != c.end(); ++it) {
+        if (!pred(*it)) {
+            *out++ = mystd::move(*it);
+        }
+    }
+
+    auto removed = static_cast<typename deque<T, A>::size_type>(c.end() - out);
+    c.erase(out, c.end());
+    return removed;
+}
+
+template <typename T, typename A, typename U>
+typename deque<T, A>::size_type erase(deque<T, A> &c, const U &value) {
+    return mystd::erase_if(c, [&value](const T &element) { return element == value; });
+}
+
+} // namespace mystd
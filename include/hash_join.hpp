@@ -0,0 +1,176 @@
+#pragma once
+
+#include "bits/hashed_key.hpp"
+#include "bits/hashtable.hpp"
+#include "bits/parallel.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace mystd {
+
+namespace detail {
+
+// Partitions are sized so that each one's hashtable stays resident in L2.
+inline constexpr std::size_t join_rows_per_partition = 4096;
+inline constexpr unsigned join_max_partition_bits = 10;
+
+template <typename Row> struct partitioned_row {
+    std::size_t hash;
+    Row *row;
+};
+
+template <typename Row> struct radix_partitions {
+    mystd::vector<partitioned_row<Row>> rows;
+    // Partition p is rows[offsets[p], offsets[p + 1]).
+    mystd::vector<std::size_t> offsets;
+};
+
+inline unsigned join_partition_bits(std::size_t rows) noexcept {
+    std::size_t partitions = (rows + join_rows_per_partition - 1) / join_rows_per_partition;
+    return std::min(static_cast<unsigned>(std::bit_width(partitions > 0 ? partitions - 1 : 0)),
+                    join_max_partition_bits);
+}
+
+// NOTE: Partitions by the top bits of the mixed hash, so rows with equal keys always meet in the
+// same partition whichever side they come from. Hashes are computed once and kept with each row
+// for the per-partition hashtable.
+template <typename Range, typename KeyFn, typename Hash>
+auto radix_partition(Range &range, KeyFn &key_fn, const Hash &hash, unsigned bits) {
+    using row_type = std::remove_reference_t<decltype(*std::begin(range))>;
+    static_assert(std::is_lvalue_reference_v<decltype(*std::begin(range))>,
+                  "mystd::hash_join() requires ranges of lvalues.");
+
+    auto partition_of = [bits](std::size_t h) -> std::size_t {
+        return bits == 0 ? 0 : mix_hash(h) >> (64 - bits);
+    };
+
+    mystd::vector<std::size_t> hashes;
+    mystd::vector<std::size_t> offsets((std::size_t{1} << bits) + 1);
+    for (auto &row : range) {
+        hashes.push_back(hash(key_fn(row)));
+        ++offsets[partition_of(hashes.back()) + 1];
+    }
+
+    for (std::size_t p = 1; p < offsets.size(); ++p) {
+        offsets[p] += offsets[p - 1];
+    }
+
+    radix_partitions<row_type> result{
+        mystd::vector<partitioned_row<row_type>>(hashes.size()),
+        offsets,
+    };
+
+    std::size_t i = 0;
+    for (auto &row : range) {
+        result.rows[offsets[partition_of(hashes[i])]++] = {hashes[i], &row};
+        ++i;
+    }
+
+    return result;
+}
+
+} // namespace detail
+
+// NOTE: An equi-join calling emit(build_row, probe_row) for every pair of rows with equal keys.
+// Both inputs are radix-partitioned by key hash so that each partition of build_range gets its
+// own cache-sized hashtable, which is then probed with the same partition of probe_range. With
+// threads > 1 partitions are joined concurrently and emit must be safe to call concurrently.
+// The order of emitted pairs is unspecified.
+template <typename BuildRange, typename ProbeRange, typename KeyFn, typename Emit>
+void hash_join(BuildRange &&build_range, ProbeRange &&probe_range, KeyFn key_fn, Emit emit,
+               std::size_t threads = 1) {
+    using key_type = std::remove_cvref_t<decltype(key_fn(*std::begin(build_range)))>;
+    using hash_type = std::hash<key_type>;
+
+    hash_type hash;
+    unsigned bits = detail::join_partition_bits(
+        static_cast<std::size_t>(std::distance(std::begin(build_range), std::end(build_range))));
+
+    auto build = detail::radix_partition(build_range, key_fn, hash, bits);
+    auto probe = detail::radix_partition(probe_range, key_fn, hash, bits);
+
+    using build_row = std::remove_pointer_t<decltype(build.rows[0].row)>;
+    using table_type = detail::hashtable<std::pair<key_type, build_row *>,
+                                         detail::key_extractor_first, hash_type, false>;
+    using hashed_key_type = typename table_type::hashed_key_type;
+
+    detail::for_each_partition(build.offsets.size() - 1, threads, [&](std::size_t p) {
+        if (probe.offsets[p] == probe.offsets[p + 1]) {
+            return;
+        }
+
+        table_type table;
+        table.reserve(build.offsets[p + 1] - build.offsets[p]);
+
+        for (std::size_t i = build.offsets[p]; i < build.offsets[p + 1]; ++i) {
+            const key_type &key = key_fn(*build.rows[i].row);
+            table.emplace(hashed_key_type::from_hash(key, build.rows[i].hash), build.rows[i].row);
+        }
+
+        for (std::size_t i = probe.offsets[p]; i < probe.offsets[p + 1]; ++i) {
+            const key_type &key = key_fn(*probe.rows[i].row);
+            auto [first, last] =
+                table.equal_range(hashed_key_type::from_hash(key, probe.rows[i].hash));
+
+            for (; first != last; ++first) {
+                emit(*first->second, *probe.rows[i].row);
+            }
+        }
+    });
+}
+
+// NOTE: Groups rows by key, folding each group into an Acc (value-initialised, then updated with
+// agg(acc, row) for each of its rows in input order), and returns one (key, acc) pair per group.
+// Rows are radix-partitioned as in hash_join(), so groups are built in cache-sized hashtables and
+// with threads > 1 partitions are aggregated concurrently. The order of groups is unspecified.
+template <typename Acc, typename Range, typename KeyFn, typename Agg>
+auto hash_group_by(Range &&range, KeyFn key_fn, Agg agg, std::size_t threads = 1) {
+    using key_type = std::remove_cvref_t<decltype(key_fn(*std::begin(range)))>;
+    using hash_type = std::hash<key_type>;
+    using table_type = detail::hashtable<std::pair<key_type, Acc>, detail::key_extractor_first,
+                                         hash_type, true>;
+    using hashed_key_type = typename table_type::hashed_key_type;
+
+    hash_type hash;
+    unsigned bits = detail::join_partition_bits(
+        static_cast<std::size_t>(std::distance(std::begin(range), std::end(range))));
+    auto input = detail::radix_partition(range, key_fn, hash, bits);
+
+    std::size_t partitions = input.offsets.size() - 1;
+    mystd::vector<mystd::vector<std::pair<key_type, Acc>>> groups(partitions);
+
+    detail::for_each_partition(partitions, threads, [&](std::size_t p) {
+        table_type table;
+
+        for (std::size_t i = input.offsets[p]; i < input.offsets[p + 1]; ++i) {
+            const key_type &key = key_fn(*input.rows[i].row);
+            auto [it, _] =
+                table.emplace(hashed_key_type::from_hash(key, input.rows[i].hash), Acc{});
+            agg(it->second, *input.rows[i].row);
+        }
+
+        groups[p].reserve(table.size());
+        for (auto &group : table) {
+            groups[p].push_back(mystd::move(group));
+        }
+    });
+
+    mystd::vector<std::pair<key_type, Acc>> result;
+    for (auto &partition : groups) {
+        for (auto &group : partition) {
+            result.push_back(mystd::move(group));
+        }
+    }
+
+    return result;
+}
+
+} // namespace mystd
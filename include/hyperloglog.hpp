@@ -0,0 +1,132 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "bits/key_traits.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+namespace mystd {
+
+// NOTE: A HyperLogLog sketch estimating the number of distinct values added to it in 2^precision
+// bytes, with a standard error of about 1.04 / sqrt(2^precision) (1.6% at the default of 12).
+// Small cardinalities fall back to linear counting over the empty registers, which is exact
+// enough to presize a table. Hashes are remixed, so weak hashes such as the identity
+// std::hash<int> are fine.
+template <typename T, typename Hash = std::hash<T>> class hyperloglog {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr unsigned min_precision = 4;
+    static constexpr unsigned max_precision = 18;
+    static constexpr unsigned default_precision = 12;
+
+private:
+    mystd::vector<std::uint8_t> _registers;
+    unsigned _precision{};
+
+    Hash _hash{};
+
+public:
+    explicit hyperloglog(unsigned precision = default_precision, const Hash &hash = Hash())
+        : _precision(precision), _hash(hash) {
+        if (precision < min_precision || precision > max_precision) {
+            throw std::invalid_argument(
+                "mystd::hyperloglog::hyperloglog() was called with an unsupported precision.");
+        }
+
+        _registers.resize(size_type{1} << precision);
+    }
+
+    unsigned precision() const noexcept { return _precision; }
+
+    void add(const value_type &value) { add_hash(_hash(value)); }
+
+    void add_hash(size_type hash) noexcept {
+        std::uint64_t mixed = detail::mix_hash(hash);
+        size_type index = mixed >> (64 - _precision);
+
+        // The rank is one more than the number of leading zeros in the remaining bits.
+        std::uint64_t rest = mixed << _precision;
+        auto rank = static_cast<std::uint8_t>(
+            std::min<unsigned>(std::countl_zero(rest), 64 - _precision) + 1);
+
+        _registers[index] = std::max(_registers[index], rank);
+    }
+
+    // NOTE: Afterwards this sketch estimates the cardinality of the union of both inputs.
+    void merge(const hyperloglog &other) {
+        if (other._precision != _precision) {
+            throw std::invalid_argument(
+                "mystd::hyperloglog::merge() was called with a sketch of another precision.");
+        }
+
+        for (size_type i = 0; i < _registers.size(); ++i) {
+            _registers[i] = std::max(_registers[i], other._registers[i]);
+        }
+    }
+
+    double estimate() const noexcept {
+        double m = static_cast<double>(_registers.size());
+
+        double sum = 0.0;
+        size_type zeros = 0;
+        for (std::uint8_t reg : _registers) {
+            sum += std::ldexp(1.0, -reg);
+            zeros += reg == 0;
+        }
+
+        double raw = _alpha() * m * m / sum;
+        if (raw <= 2.5 * m && zeros != 0) {
+            return m * std::log(m / static_cast<double>(zeros));
+        }
+        return raw;
+    }
+
+    // The relative standard error of estimate().
+    double error() const noexcept {
+        return 1.04 / std::sqrt(static_cast<double>(_registers.size()));
+    }
+
+    void clear() noexcept { mystd::fill(_registers.begin(), _registers.end(), std::uint8_t{0}); }
+
+private:
+    double _alpha() const noexcept {
+        switch (_registers.size()) {
+        case 16:
+            return 0.673;
+        case 32:
+            return 0.697;
+        case 64:
+            return 0.709;
+        default:
+            return 0.7213 / (1.0 + 1.079 / static_cast<double>(_registers.size()));
+        }
+    }
+};
+
+namespace detail {
+
+// Estimates the number of distinct keys in [first, last) in one pass, padded by two standard
+// errors so that the estimate rarely falls short.
+template <typename Key, typename Hash, typename KeyExtractor, typename I>
+std::size_t estimate_distinct_keys(I first, I last, const Hash &hash,
+                                   const KeyExtractor &extract_key) {
+    mystd::hyperloglog<Key, Hash> sketch(mystd::hyperloglog<Key, Hash>::default_precision, hash);
+    for (; first != last; ++first) {
+        sketch.add(extract_key(*first));
+    }
+
+    return static_cast<std::size_t>(std::ceil(sketch.estimate() * (1.0 + 2.0 * sketch.error())));
+}
+
+} // namespace detail
+
+} // namespace mystd
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "bits/index_table.hpp"
+
+#include "utility.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace mystd {
+
+// NOTE: An insertion-ordered map whose entries are stored contiguously. Unlike unordered_map,
+// erase() moves the last entry into the erased position (use shift_erase() to keep insertion
+// order), and iterators and references are invalidated by any insertion or erasure.
+template <typename K, typename V, typename Hash = std::hash<K>> class index_map {
+    using _table_type = detail::index_table<std::pair<K, V>, detail::key_extractor_first, Hash>;
+    _table_type _table;
+
+public:
+    using key_type = typename _table_type::key_type;
+    using mapped_type = V;
+    using value_type = typename _table_type::value_type;
+    using size_type = typename _table_type::size_type;
+    using difference_type = typename _table_type::difference_type;
+    using iterator = typename _table_type::iterator;
+    using const_iterator = typename _table_type::const_iterator;
+
+    index_map() = default;
+
+    // Iterators.
+    iterator begin() noexcept { return _table.begin(); }
+    const_iterator begin() const noexcept { return _table.begin(); }
+    const_iterator cbegin() const noexcept { return _table.cbegin(); }
+
+    iterator end() noexcept { return _table.end(); }
+    const_iterator end() const noexcept { return _table.end(); }
+    const_iterator cend() const noexcept { return _table.cend(); }
+
+    // Capacity.
+    bool empty() const noexcept { return _table.empty(); }
+    size_type size() const noexcept { return _table.size(); }
+    size_type max_size() const noexcept { return _table.max_size(); }
+    void reserve(size_type count) { _table.reserve(count); }
+
+    // Modifiers.
+    template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+        return _table.emplace(mystd::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value) { return _table.insert(value); }
+    std::pair<iterator, bool> insert(value_type &&value) { return _table.insert(std::move(value)); }
+    template <mystd::input_iterator I> void insert(I first, I last) { _table.insert(first, last); }
+    void insert(std::initializer_list<value_type> il) { _table.insert(il); }
+
+    iterator erase(const_iterator pos) { return _table.erase(pos); }
+    size_type erase(const key_type &key) { return _table.erase(key); }
+
+    iterator shift_erase(const_iterator pos) { return _table.shift_erase(pos); }
+    size_type shift_erase(const key_type &key) { return _table.shift_erase(key); }
+
+    void swap(index_map &other) noexcept { return _table.swap(other._table); }
+
+    void clear() noexcept { return _table.clear(); }
+
+    // Lookup.
+    iterator find(const key_type &key) noexcept { return _table.find(key); }
+    const_iterator find(const key_type &key) const noexcept { return _table.find(key); }
+
+    bool contains(const key_type &key) const noexcept { return _table.contains(key); }
+
+    size_type count(const key_type &key) const noexcept { return _table.count(key); }
+
+    mapped_type &operator[](const key_type &key) {
+        auto [it, _] = emplace(key, mapped_type{});
+        return it->second;
+    }
+
+    mapped_type &operator[](key_type &&key) {
+        auto [it, _] = emplace(std::move(key), mapped_type{});
+        return it->second;
+    }
+
+    mapped_type &at(const key_type &key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("mystd::index_map::at() was called with a non-existent key.");
+        }
+
+        return it->second;
+    }
+
+    const mapped_type &at(const key_type &key) const {
+        return const_cast<index_map *>(this)->at(key);
+    }
+};
+
+} // namespace mystd
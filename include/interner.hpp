@@ -0,0 +1,176 @@
+#pragma once
+
+#include "bits/index_table.hpp"
+#include "vector.hpp"
+
+#include "utility.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace mystd {
+
+namespace detail {
+
+struct interned_string {
+    std::size_t hash;
+    const char *data;
+    std::size_t size;
+};
+
+} // namespace detail
+
+// NOTE: Interned bytes are appended to fixed-size arena chunks that are never moved or freed
+// before clear(), so a string costs its bytes plus one (hash, pointer, size) entry rather than a
+// node and a separate heap string. Symbols are dense 32-bit indices into the entries, found from
+// a string_view through a detail::slot_index without allocating. Views returned by view() stay
+// valid until clear() or destruction.
+class interner {
+public:
+    using symbol = std::uint32_t;
+    using size_type = std::size_t;
+
+private:
+    static constexpr size_type _chunk_size = 64 * 1024;
+
+    mystd::vector<detail::interned_string> _entries;
+    detail::slot_index _index;
+
+    mystd::vector<std::unique_ptr<char[]>> _chunks;
+    char *_chunk_cursor{};
+    size_type _chunk_remaining{};
+
+    std::hash<std::string_view> _hash{};
+
+public:
+    interner() = default;
+
+    // NOTE: Moves keep every interned byte in place and leave the source empty, so interning into
+    // it again starts a chunk of its own; copies would have to re-intern everything.
+    interner(const interner &) = delete;
+    interner &operator=(const interner &) = delete;
+    interner(interner &&other) noexcept { swap(other); }
+    interner &operator=(interner &&other) noexcept {
+        interner temp(mystd::move(other));
+        swap(temp);
+        return *this;
+    }
+
+    // Capacity.
+    bool empty() const noexcept { return _entries.empty(); }
+    size_type size() const noexcept { return _entries.size(); }
+    size_type max_size() const noexcept { return detail::slot_index::max_entries; }
+
+    void reserve(size_type count) {
+        _entries.reserve(count);
+
+        if (_index.needs_growth(count)) {
+            _index.rebuild(size(), count, [this](size_type i) { return _entries[i].hash; });
+        }
+    }
+
+    // Modifiers.
+    symbol intern(std::string_view str) {
+        size_type hash = _hash(str);
+
+        if (auto existing = _find(str, hash); existing != detail::slot_index::npos) {
+            return existing;
+        }
+
+        if (size() >= max_size()) {
+            throw std::length_error("mystd::interner::intern() exceeded max_size().");
+        }
+        if (_index.needs_growth(size())) {
+            _index.rebuild(size(), size() + 1, [this](size_type i) { return _entries[i].hash; });
+        }
+
+        _entries.push_back({hash, _store(str), str.size()});
+
+        auto sym = static_cast<symbol>(size() - 1);
+        _index.insert(hash, sym);
+        return sym;
+    }
+
+    void clear() noexcept {
+        _entries.clear();
+        _index.clear();
+        _chunks.clear();
+        _chunk_cursor = nullptr;
+        _chunk_remaining = 0;
+    }
+
+    void swap(interner &other) noexcept {
+        _entries.swap(other._entries);
+        _index.swap(other._index);
+        _chunks.swap(other._chunks);
+        mystd::swap(_chunk_cursor, other._chunk_cursor);
+        mystd::swap(_chunk_remaining, other._chunk_remaining);
+    }
+
+    // Lookup.
+    std::optional<symbol> find(std::string_view str) const noexcept {
+        auto sym = _find(str, _hash(str));
+        return sym == detail::slot_index::npos ? std::nullopt : std::optional<symbol>(sym);
+    }
+
+    bool contains(std::string_view str) const noexcept { return find(str).has_value(); }
+
+    std::string_view view(symbol sym) const noexcept {
+        return {_entries[sym].data, _entries[sym].size};
+    }
+    std::string_view operator[](symbol sym) const noexcept { return view(sym); }
+
+    std::string_view at(symbol sym) const {
+        if (sym >= size()) {
+            throw std::out_of_range("mystd::interner::at() was called with an unknown symbol.");
+        }
+
+        return view(sym);
+    }
+
+private:
+    symbol _find(std::string_view str, size_type hash) const noexcept {
+        return _index.find(hash, [&](symbol i) {
+            const detail::interned_string &e = _entries[i];
+            return e.hash == hash && std::string_view(e.data, e.size) == str;
+        });
+    }
+
+    // Copies the bytes into the arena. Strings over a quarter of a chunk get a chunk of their
+    // own, so they neither waste the tail of the current chunk nor force a new one.
+    const char *_store(std::string_view str) {
+        if (str.empty()) {
+            return "";
+        }
+
+        if (str.size() > _chunk_size / 4) {
+            auto chunk = std::make_unique_for_overwrite<char[]>(str.size());
+            std::memcpy(chunk.get(), str.data(), str.size());
+
+            _chunks.push_back(mystd::move(chunk));
+            return _chunks.back().get();
+        }
+
+        if (str.size() > _chunk_remaining) {
+            _chunks.push_back(std::make_unique_for_overwrite<char[]>(_chunk_size));
+            _chunk_cursor = _chunks.back().get();
+            _chunk_remaining = _chunk_size;
+        }
+
+        char *data = _chunk_cursor;
+        std::memcpy(data, str.data(), str.size());
+        _chunk_cursor += str.size();
+        _chunk_remaining -= str.size();
+
+        return data;
+    }
+};
+
+} // namespace mystd
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "bits/hashtable.hpp"
+#include "bits/iterator_base_types.hpp"
+#include "bits/iterator_reverse.hpp"
+
+#include "utility.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mystd {
+
+namespace detail {
+
+struct lru_links {
+    lru_links *prev{};
+    lru_links *next{};
+};
+
+// NOTE: The recency links live in the same allocation as the hashtable node, so an entry costs
+// a single allocation and touching it never leaves the node. The entry also points back at its
+// node, so the least recently used entry is erased without hashing its key again.
+template <typename K, typename V> struct lru_entry : lru_links {
+    std::pair<K, V> kv{};
+    node<lru_entry> *self{};
+
+    lru_entry() = default;
+    template <typename KK, typename VV>
+    lru_entry(KK &&key, VV &&value) : kv(mystd::forward<KK>(key), mystd::forward<VV>(value)) {}
+};
+
+struct key_extractor_lru {
+    template <typename Entry> const auto &operator()(const Entry &e) const noexcept {
+        return e.kv.first;
+    }
+};
+
+struct lru_noop_evict {
+    template <typename K, typename V> void operator()(const K &, V &) const noexcept {}
+};
+
+template <typename Entry, bool IsConst = false> class lru_iterator {
+    template <typename U, bool OtherConst> friend class lru_iterator;
+
+    using _links_type = std::conditional_t<IsConst, const lru_links, lru_links>;
+    using _entry_type = std::conditional_t<IsConst, const Entry, Entry>;
+
+    _links_type *_links{};
+
+public:
+    using iterator_category = mystd::bidirectional_iterator_tag;
+    using value_type = decltype(Entry::kv);
+    using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+    using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+    using difference_type = std::ptrdiff_t;
+
+    lru_iterator() = default;
+    explicit lru_iterator(_links_type *links) : _links(links) {}
+    template <bool OtherConst>
+    lru_iterator(const lru_iterator<Entry, OtherConst> &other)
+        requires(IsConst || !OtherConst)
+        : _links(other._links) {}
+
+    lru_iterator &operator++() noexcept {
+        _links = _links->next;
+        return *this;
+    }
+
+    lru_iterator operator++(int) noexcept {
+        lru_iterator tmp = *this;
+        _links = _links->next;
+        return tmp;
+    }
+
+    lru_iterator &operator--() noexcept {
+        _links = _links->prev;
+        return *this;
+    }
+
+    lru_iterator operator--(int) noexcept {
+        lru_iterator tmp = *this;
+        _links = _links->prev;
+        return tmp;
+    }
+
+    reference operator*() const noexcept { return static_cast<_entry_type *>(_links)->kv; }
+    pointer operator->() const noexcept { return std::addressof(operator*()); }
+
+    template <bool OtherConst>
+    friend bool operator==(const lru_iterator &lhs, const lru_iterator<Entry, OtherConst> &rhs) {
+        return lhs._links == rhs._links;
+    }
+};
+
+} // namespace detail
+
+// NOTE: Iteration runs from the most to the least recently used entry. The eviction callback is
+// invoked as on_evict(key, value) immediately before an entry is destroyed by capacity pressure
+// or evict(); erase() and clear() do not invoke it. If the callback throws, the entry it was
+// given stays cached and in place, along with any entry that put() was inserting.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename OnEvict = detail::lru_noop_evict>
+class lru_cache {
+    using _entry_type = detail::lru_entry<K, V>;
+    using _hashtable = detail::hashtable<_entry_type, detail::key_extractor_lru, Hash, true>;
+
+    _hashtable _table;
+    detail::lru_links _head{&_head, &_head};
+    std::size_t _capacity{};
+    [[no_unique_address]] OnEvict _on_evict{};
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = std::size_t;
+    using iterator = detail::lru_iterator<_entry_type, false>;
+    using const_iterator = detail::lru_iterator<_entry_type, true>;
+    using reverse_iterator = mystd::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystd::reverse_iterator<const_iterator>;
+
+    // Construction.
+    // NOTE: The table grows with the entries rather than being sized for capacity up front; call
+    // reserve() to presize it for a cache that is expected to fill.
+    explicit lru_cache(size_type capacity, OnEvict on_evict = OnEvict())
+        : _capacity(capacity), _on_evict(mystd::move(on_evict)) {}
+
+    // NOTE: The sentinel is referenced by the first and last entries, so the cache is pinned.
+    lru_cache(const lru_cache &) = delete;
+    lru_cache &operator=(const lru_cache &) = delete;
+
+    // Iterators.
+    iterator begin() noexcept { return iterator(_head.next); }
+    const_iterator begin() const noexcept { return const_iterator(_head.next); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(&_head); }
+    const_iterator end() const noexcept { return const_iterator(&_head); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+    // Capacity.
+    bool empty() const noexcept { return _table.empty(); }
+    size_type size() const noexcept { return _table.size(); }
+    size_type max_size() const noexcept { return std::numeric_limits<size_type>::max(); }
+    size_type capacity() const noexcept { return _capacity; }
+
+    void set_capacity(size_type capacity) {
+        _capacity = capacity;
+        if (size() > capacity) {
+            evict(size() - capacity);
+        }
+    }
+
+    void reserve(size_type count) { _table.reserve(count); }
+
+    // Lookup.
+    mapped_type *get(const key_type &key) {
+        auto it = _table.find(key);
+        if (it == _table.end()) {
+            return nullptr;
+        }
+
+        _move_to_front(std::addressof(*it));
+        return std::addressof(it->kv.second);
+    }
+
+    const mapped_type *peek(const key_type &key) const noexcept {
+        auto it = _table.find(key);
+        return it == _table.end() ? nullptr : std::addressof(it->kv.second);
+    }
+
+    bool contains(const key_type &key) const noexcept { return _table.contains(key); }
+
+    bool touch(const key_type &key) {
+        auto it = _table.find(key);
+        if (it == _table.end()) {
+            return false;
+        }
+
+        _move_to_front(std::addressof(*it));
+        return true;
+    }
+
+    // Modifiers.
+    template <typename M> std::pair<iterator, bool> put(const key_type &key, M &&value) {
+        return _put(key, mystd::forward<M>(value));
+    }
+
+    template <typename M> std::pair<iterator, bool> put(key_type &&key, M &&value) {
+        return _put(mystd::move(key), mystd::forward<M>(value));
+    }
+
+    size_type erase(const key_type &key) {
+        auto it = _table.find(key);
+        if (it == _table.end()) {
+            return 0;
+        }
+
+        _unlink(std::addressof(*it));
+        _table.erase(it);
+        return 1;
+    }
+
+    // Evicts up to count of the least recently used entries, returning how many were evicted.
+    size_type evict(size_type count) {
+        size_type evicted = 0;
+        for (; evicted < count && !empty(); ++evicted) {
+            auto *lru = static_cast<_entry_type *>(_head.prev);
+
+            _on_evict(lru->kv.first, lru->kv.second);
+            _unlink(lru);
+            _table.erase(typename _hashtable::const_iterator(lru->self));
+        }
+
+        return evicted;
+    }
+
+    void clear() noexcept {
+        _table.clear();
+        _head.prev = _head.next = &_head;
+    }
+
+private:
+    template <typename KK, typename M> std::pair<iterator, bool> _put(KK &&key, M &&value) {
+        typename _hashtable::hashed_key_type hk(key);
+        if (auto it = _table.find(hk); it != _table.end()) {
+            it->kv.second = mystd::forward<M>(value);
+            _move_to_front(std::addressof(*it));
+            return {iterator(std::addressof(*it)), false};
+        }
+
+        auto [it, _] =
+            _table.insert(hk, _entry_type(mystd::forward<KK>(key), mystd::forward<M>(value)));
+        it->self = it.node();
+        _link_front(std::addressof(*it));
+
+        if (size() > capacity()) {
+            evict(size() - capacity());
+        }
+
+        return {capacity() == 0 ? end() : begin(), true};
+    }
+
+    void _unlink(detail::lru_links *links) noexcept {
+        links->prev->next = links->next;
+        links->next->prev = links->prev;
+    }
+
+    void _link_front(detail::lru_links *links) noexcept {
+        links->prev = &_head;
+        links->next = _head.next;
+        _head.next->prev = links;
+        _head.next = links;
+    }
+
+    void _move_to_front(detail::lru_links *links) noexcept {
+        if (_head.next != links) {
+            _unlink(links);
+            _link_front(links);
+        }
+    }
+};
+
+} // namespace mystd
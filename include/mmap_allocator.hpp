@@ -0,0 +1,186 @@
+#pragma once
+
+#include "memory.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace mystd {
+
+// NOTE: A Linux allocator for very large buffers. Blocks of at least mmap_threshold bytes are
+// anonymous mappings, which reallocate() grows with mremap(MREMAP_MAYMOVE) by remapping pages
+// rather than copying them, and shrinks by returning the tail pages with madvise(MADV_DONTNEED).
+// Each mapping starts with a header recording its length, so a shrunk block can grow back into
+// its own mapping and is always unmapped whole. Smaller blocks come from malloc(), as with
+// mystd::allocator, or from aligned operator new for over-aligned types.
+//
+// Whether a block is mapped follows from its size in bytes, so every block must be deallocated,
+// expanded and reallocated with the element count it currently has.
+template <typename T> class mmap_allocator {
+    struct alignas(64) _header {
+        std::size_t length;
+    };
+
+    static_assert(alignof(T) <= alignof(_header),
+                  "mystd::mmap_allocator does not support over-aligned types.");
+
+    static constexpr bool _over_aligned = alignof(T) > alignof(std::max_align_t);
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t mmap_threshold = std::size_t{1} << 20;
+
+    mmap_allocator() noexcept = default;
+    mmap_allocator(const mmap_allocator &other) noexcept = default;
+    template <typename U> mmap_allocator(const mmap_allocator<U> &other) noexcept {};
+
+    ~mmap_allocator() = default;
+
+    T *allocate(size_type n) {
+        if (n > (std::numeric_limits<size_type>::max() - _page_size()) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        if (!_mapped(n)) {
+            if constexpr (_over_aligned) {
+                return static_cast<T *>(
+                    ::operator new(sizeof(T) * n, std::align_val_t(alignof(T))));
+            }
+
+            void *p = std::malloc(n == 0 ? 1 : sizeof(T) * n);
+            if (!p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(p);
+        }
+
+        std::size_t length = _length(n);
+        void *base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                            -1, 0);
+        if (base == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        static_cast<_header *>(base)->length = length;
+        return _data(base);
+    }
+
+    void deallocate(T *p, size_type n) noexcept {
+        if (!_mapped(n)) {
+            if constexpr (_over_aligned) {
+                ::operator delete(p, std::align_val_t(alignof(T)));
+            } else {
+                std::free(p);
+            }
+            return;
+        }
+
+        _header *base = _base(p);
+        ::munmap(base, base->length);
+    }
+
+    // Grows a block in place: within its mapping, by extending the mapping into free address space
+    // after it, or within the slack malloc() left after a small block.
+    bool try_expand(T *p, size_type old_n, size_type new_n) noexcept {
+        if (new_n > (std::numeric_limits<size_type>::max() - _page_size()) / sizeof(T)) {
+            return false;
+        }
+
+        if (!_mapped(old_n)) {
+            return !_over_aligned && !_mapped(new_n) &&
+                   new_n <= ::malloc_usable_size(p) / sizeof(T);
+        }
+
+        _header *base = _base(p);
+        std::size_t length = _length(new_n);
+        if (length <= base->length) {
+            return true;
+        }
+
+        if (::mremap(base, base->length, length, 0) == MAP_FAILED) {
+            return false;
+        }
+
+        base->length = length;
+        return true;
+    }
+
+    // Resizes a block without copying it where possible. Only valid for trivially relocatable T.
+    T *reallocate(T *p, size_type old_n, size_type new_n) {
+        if (new_n > (std::numeric_limits<size_type>::max() - _page_size()) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        if (!_over_aligned && !_mapped(old_n) && !_mapped(new_n)) {
+            void *new_p = std::realloc(static_cast<void *>(p), new_n == 0 ? 1 : sizeof(T) * new_n);
+            if (!new_p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(new_p);
+        }
+
+        if (!_mapped(old_n) || !_mapped(new_n)) {
+            T *new_p = allocate(new_n);
+            std::memcpy(static_cast<void *>(new_p), static_cast<const void *>(p),
+                        sizeof(T) * (old_n < new_n ? old_n : new_n));
+            deallocate(p, old_n);
+            return new_p;
+        }
+
+        _header *base = _base(p);
+        std::size_t length = _length(new_n);
+        if (length <= base->length) {
+            // Keep the mapping, but hand its unused pages back to the kernel.
+            ::madvise(reinterpret_cast<char *>(base) + length, base->length - length,
+                      MADV_DONTNEED);
+            return p;
+        }
+
+        void *new_base = ::mremap(base, base->length, length, MREMAP_MAYMOVE);
+        if (new_base == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        static_cast<_header *>(new_base)->length = length;
+        return _data(new_base);
+    }
+
+private:
+    static std::size_t _page_size() noexcept {
+        static const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return page_size;
+    }
+
+    static bool _mapped(size_type n) noexcept { return sizeof(T) * n >= mmap_threshold; }
+
+    // The length of a mapping holding the header and n elements, in whole pages.
+    static std::size_t _length(size_type n) noexcept {
+        std::size_t bytes = sizeof(_header) + sizeof(T) * n;
+        return (bytes + _page_size() - 1) & ~(_page_size() - 1);
+    }
+
+    static T *_data(void *base) noexcept {
+        return reinterpret_cast<T *>(static_cast<_header *>(base) + 1);
+    }
+
+    static _header *_base(T *p) noexcept { return reinterpret_cast<_header *>(p) - 1; }
+};
+
+template <typename T1, typename T2>
+bool operator==(const mmap_allocator<T1> &lhs, const mmap_allocator<T2> &rhs) {
+    return true;
+}
+
+} // namespace mystd
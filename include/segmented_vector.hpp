@@ -0,0 +1,567 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+namespace mystd {
+
+template <typename T, typename A> class segmented_vector;
+
+namespace detail {
+
+// A position in a segmented_vector, caching the bounds of its segment so that stepping within a
+// segment is a pointer increment. Crossing into another segment asks the owning container.
+template <typename T, typename A, bool IsConst = false> class segmented_iterator {
+    template <typename U, typename B, bool OtherConst> friend class segmented_iterator;
+    friend class mystd::segmented_vector<T, A>;
+
+    using owner_type = const mystd::segmented_vector<T, A>;
+
+    owner_type *_owner{};
+    std::size_t _index{};
+    T *_ptr{};
+    T *_segment_begin{};
+    T *_segment_end{};
+
+    segmented_iterator(owner_type *owner, std::size_t index) : _owner(owner), _index(index) {
+        _seek();
+    }
+
+public:
+    using iterator_category = mystd::random_access_iterator_tag;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+
+    segmented_iterator() = default;
+    template <bool OtherConst>
+    segmented_iterator(const segmented_iterator<T, A, OtherConst> &other)
+        requires(IsConst || !OtherConst)
+        : _owner(other._owner), _index(other._index), _ptr(other._ptr),
+          _segment_begin(other._segment_begin), _segment_end(other._segment_end) {}
+
+    reference operator*() const noexcept { return *_ptr; }
+    pointer operator->() const noexcept { return _ptr; }
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    segmented_iterator &operator++() noexcept {
+        ++_index;
+        if (++_ptr == _segment_end) {
+            _seek();
+        }
+        return *this;
+    }
+
+    segmented_iterator operator++(int) noexcept {
+        segmented_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    segmented_iterator &operator--() noexcept {
+        --_index;
+        if (_ptr == _segment_begin) {
+            _seek();
+        } else {
+            --_ptr;
+        }
+        return *this;
+    }
+
+    segmented_iterator operator--(int) noexcept {
+        segmented_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    segmented_iterator &operator+=(difference_type n) noexcept {
+        _index += n;
+        if (n >= _segment_end - _ptr || n < _segment_begin - _ptr) {
+            _seek();
+        } else {
+            _ptr += n;
+        }
+        return *this;
+    }
+
+    segmented_iterator &operator-=(difference_type n) noexcept { return *this += -n; }
+
+    segmented_iterator operator+(difference_type n) const noexcept {
+        segmented_iterator tmp = *this;
+        return tmp += n;
+    }
+
+    segmented_iterator operator-(difference_type n) const noexcept {
+        segmented_iterator tmp = *this;
+        return tmp -= n;
+    }
+
+    friend segmented_iterator operator+(difference_type n, const segmented_iterator &it) noexcept {
+        return it + n;
+    }
+
+    template <bool OtherConst>
+    difference_type operator-(const segmented_iterator<T, A, OtherConst> &other) const noexcept {
+        return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+    }
+
+    template <bool OtherConst>
+    bool operator==(const segmented_iterator<T, A, OtherConst> &other) const noexcept {
+        return _index == other._index;
+    }
+
+    template <bool OtherConst>
+    auto operator<=>(const segmented_iterator<T, A, OtherConst> &other) const noexcept {
+        return _index <=> other._index;
+    }
+
+private:
+    void _seek() noexcept { _owner->_seek(_index, _ptr, _segment_begin, _segment_end); }
+};
+
+} // namespace detail
+
+// NOTE: A vector whose elements never move. Storage is a list of segments, each twice the size of
+// the one before, so the segment holding an index is found with a bit scan and indexing stays
+// constant time. Growing adds a segment and leaves existing elements where they are, so pointers
+// and references to elements stay valid until the elements themselves are removed; iterators stay
+// valid as long as the container is not moved or swapped.
+//
+// Elements can only be added and removed at the back. segment() exposes each segment as a
+// contiguous span, for loops that want to process elements in bulk.
+template <typename T, typename A = mystd::allocator<T>> class segmented_vector {
+    template <typename U, typename B, bool IsConst> friend class detail::segmented_iterator;
+
+public:
+    using value_type = T;
+    using allocator_type = A;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = mystd::allocator_traits<allocator_type>::pointer;
+    using const_pointer = mystd::allocator_traits<allocator_type>::const_pointer;
+    using iterator = detail::segmented_iterator<T, A>;
+    using const_iterator = detail::segmented_iterator<T, A, true>;
+    using reverse_iterator = mystd::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystd::reverse_iterator<const_iterator>;
+
+    // The capacity of the first segment, chosen so that it spans about 512 bytes.
+    static constexpr size_type first_segment_size =
+        std::bit_ceil(std::max<size_type>(1, 512 / sizeof(T)));
+
+private:
+    static constexpr size_type _first_shift = std::countr_zero(first_segment_size);
+    static constexpr size_type _max_segments =
+        std::numeric_limits<size_type>::digits - _first_shift - 1;
+
+    [[no_unique_address]] A _allocator{};
+
+    mystd::vector<pointer> _segments;
+    size_type _size{};
+
+    // Where the next element goes, and the end of its segment. Equal when the next element needs
+    // another segment, so that emplace_back() only has to compare them.
+    pointer _next{};
+    pointer _next_end{};
+
+public:
+    // Construction.
+    segmented_vector() noexcept(noexcept(allocator_type())) : segmented_vector(allocator_type()) {}
+
+    explicit segmented_vector(const allocator_type &allocator) noexcept : _allocator(allocator) {}
+
+    explicit segmented_vector(size_type count, const allocator_type &allocator = allocator_type())
+        : segmented_vector(allocator) {
+        resize(count);
+    }
+
+    segmented_vector(size_type count, const_reference value,
+                     const allocator_type &allocator = allocator_type())
+        : segmented_vector(allocator) {
+        resize(count, value);
+    }
+
+    // NOTE: The constructors delegating to this one need no cleanup of their own, as the
+    // destructor runs if they throw.
+    template <mystd::input_iterator I>
+    segmented_vector(I first, I last, const allocator_type &allocator = allocator_type())
+        : segmented_vector(allocator) {
+        if constexpr (mystd::forward_iterator<I>) {
+            reserve(static_cast<size_type>(mystd::distance(first, last)));
+        }
+
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    segmented_vector(const segmented_vector &other)
+        : segmented_vector(mystd::allocator_traits<allocator_type>::
+                               select_on_container_copy_construction(other._allocator)) {
+        _copy_from(other);
+    }
+
+    segmented_vector(const segmented_vector &other, const allocator_type &allocator)
+        : segmented_vector(allocator) {
+        _copy_from(other);
+    }
+
+    segmented_vector(segmented_vector &&other) noexcept
+        : _allocator(std::move(other._allocator)) {
+        _take(other);
+    }
+
+    segmented_vector(std::initializer_list<value_type> il,
+                     const allocator_type &allocator = allocator_type())
+        : segmented_vector(il.begin(), il.end(), allocator) {};
+
+    ~segmented_vector() { _free(); }
+
+    segmented_vector &operator=(const segmented_vector &other) {
+        if (this != &other) {
+            // The copy allocates with the allocator this container keeps afterwards.
+            constexpr bool propagate = mystd::allocator_traits<
+                allocator_type>::propagate_on_container_copy_assignment::value;
+            segmented_vector temp(other, propagate ? other._allocator : _allocator);
+
+            _free();
+            _allocator = temp._allocator;
+            _take(temp);
+        }
+
+        return *this;
+    }
+
+    segmented_vector &operator=(segmented_vector &&other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        constexpr bool propagate =
+            mystd::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+        if (propagate || _allocator == other._allocator) {
+            _free();
+            if constexpr (propagate) {
+                _allocator = std::move(other._allocator);
+            }
+            _take(other);
+        } else {
+            clear();
+            reserve(other.size());
+            for (auto &element : other) {
+                emplace_back(mystd::move(element));
+            }
+        }
+
+        return *this;
+    }
+
+    segmented_vector &operator=(std::initializer_list<value_type> il) {
+        *this = segmented_vector(il, _allocator);
+        return *this;
+    }
+
+    // Access.
+    reference operator[](size_type pos) noexcept {
+        auto [segment, offset] = _locate(pos);
+        return _segments[segment][offset];
+    }
+    const_reference operator[](size_type pos) const noexcept {
+        auto [segment, offset] = _locate(pos);
+        return _segments[segment][offset];
+    }
+
+    reference front() noexcept { return *_segments[0]; }
+    const_reference front() const noexcept { return *_segments[0]; }
+
+    reference back() noexcept { return (*this)[_size - 1]; }
+    const_reference back() const noexcept { return (*this)[_size - 1]; }
+
+    reference at(size_type pos) {
+        if (pos >= size()) {
+            throw std::out_of_range(
+                "mystd::segmented_vector::at() was called with an index out of bounds.");
+        }
+        return (*this)[pos];
+    }
+    const_reference at(size_type pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range(
+                "mystd::segmented_vector::at() was called with an index out of bounds.");
+        }
+        return (*this)[pos];
+    }
+
+    allocator_type get_allocator() const noexcept { return _allocator; }
+
+    // The number of segments holding elements.
+    size_type segment_count() const noexcept {
+        return _size == 0 ? 0 : _locate(_size - 1).first + 1;
+    }
+
+    // The elements of a segment, for k < segment_count(). Every segment but the last is full.
+    std::span<T> segment(size_type k) noexcept {
+        return std::span<T>(_segments[k], _segment_length(k));
+    }
+    std::span<const T> segment(size_type k) const noexcept {
+        return std::span<const T>(_segments[k], _segment_length(k));
+    }
+
+    // Iterators.
+    iterator begin() noexcept { return iterator(this, 0); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, _size); }
+    const_iterator end() const noexcept { return const_iterator(this, _size); }
+    const_iterator cend() const noexcept { return const_iterator(this, _size); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+    // Capacity.
+    bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+    size_type max_size() const noexcept { return _segment_start(_max_segments); }
+    size_type capacity() const noexcept { return _segment_start(_segments.size()); }
+
+    void reserve(size_type new_cap) {
+        if (new_cap <= capacity()) {
+            return;
+        }
+
+        if (new_cap > max_size()) {
+            throw std::length_error(
+                "mystd::segmented_vector::reserve() was called with too large a capacity.");
+        }
+
+        while (capacity() < new_cap) {
+            _add_segment();
+        }
+        _sync();
+    }
+
+    // Frees the segments that hold no elements.
+    void shrink_to_fit() {
+        for (size_type k = _segments.size(); k > segment_count(); --k) {
+            mystd::allocator_traits<allocator_type>::deallocate(_allocator, _segments.back(),
+                                                                _segment_size(k - 1));
+            _segments.pop_back();
+        }
+        _segments.shrink_to_fit();
+        _sync();
+    }
+
+    // Modifiers.
+    // NOTE: The arguments may refer to elements, which is safe as elements never move.
+    template <typename... Args> reference emplace_back(Args &&...args) {
+        if (_next == _next_end) [[unlikely]] {
+            _advance();
+        }
+
+        mystd::allocator_traits<allocator_type>::construct(_allocator, _next,
+                                                           mystd::forward<Args>(args)...);
+        ++_size;
+        return *_next++;
+    }
+
+    void push_back(const_reference value) { emplace_back(value); }
+    void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        mystd::allocator_traits<allocator_type>::destroy(_allocator, std::addressof(back()));
+        --_size;
+        _sync();
+    }
+
+    void clear() noexcept { _destroy_from(0); }
+
+    void resize(size_type count, const_reference value) {
+        if (count < size()) {
+            _destroy_from(count);
+            return;
+        }
+
+        reserve(count);
+        while (size() < count) {
+            emplace_back(value);
+        }
+    }
+
+    void resize(size_type count) {
+        if (count < size()) {
+            _destroy_from(count);
+            return;
+        }
+
+        reserve(count);
+        while (size() < count) {
+            emplace_back();
+        }
+    }
+
+    // NOTE: It is UB to call swap() on containers with different allocators.
+    void swap(segmented_vector &other) noexcept {
+        if constexpr (mystd::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+            mystd::swap(_allocator, other._allocator);
+        }
+
+        _segments.swap(other._segments);
+        mystd::swap(_size, other._size);
+        mystd::swap(_next, other._next);
+        mystd::swap(_next_end, other._next_end);
+    }
+
+private:
+    static constexpr size_type _segment_size(size_type k) noexcept {
+        return first_segment_size << k;
+    }
+
+    // The index of the first element of segment k, which is also the capacity of the segments
+    // before it.
+    static constexpr size_type _segment_start(size_type k) noexcept {
+        return (first_segment_size << k) - first_segment_size;
+    }
+
+    // Returns the segment holding index and the offset of index within it.
+    static std::pair<size_type, size_type> _locate(size_type index) noexcept {
+        size_type biased = index + first_segment_size;
+        size_type segment = std::bit_width(biased) - 1 - _first_shift;
+        return {segment, biased - (first_segment_size << segment)};
+    }
+
+    size_type _segment_length(size_type k) const noexcept {
+        return std::min(_segment_size(k), _size - _segment_start(k));
+    }
+
+    // Points an iterator at index, or at nothing if index is past the last segment.
+    void _seek(size_type index, T *&ptr, T *&segment_begin, T *&segment_end) const noexcept {
+        auto [segment, offset] = _locate(index);
+        if (segment >= _segments.size()) {
+            ptr = segment_begin = segment_end = nullptr;
+            return;
+        }
+
+        segment_begin = _segments[segment];
+        segment_end = segment_begin + _segment_size(segment);
+        ptr = segment_begin + offset;
+    }
+
+    // Points _next and _next_end at the slot for the next element.
+    void _sync() noexcept {
+        if (_size == capacity()) {
+            _next = _next_end = nullptr;
+            return;
+        }
+
+        auto [segment, offset] = _locate(_size);
+        _next = _segments[segment] + offset;
+        _next_end = _segments[segment] + _segment_size(segment);
+    }
+
+    void _add_segment() {
+        if (_segments.size() == _max_segments) {
+            throw std::length_error("mystd::segmented_vector grew beyond max_size().");
+        }
+
+        size_type k = _segments.size();
+        _segments.reserve(k + 1);
+        _segments.push_back(
+            mystd::allocator_traits<allocator_type>::allocate(_allocator, _segment_size(k)));
+    }
+
+    // The slow path of emplace_back(), run when the current segment is full.
+    void _advance() {
+        if (_size == capacity()) {
+            _add_segment();
+        }
+        _sync();
+    }
+
+    // Destroys the elements from index onwards, a segment at a time.
+    void _destroy_from(size_type index) noexcept {
+        while (_size > index) {
+            auto [segment, offset] = _locate(_size - 1);
+            size_type first = std::max(index, _segment_start(segment));
+
+            pointer base = _segments[segment];
+            mystd::destroy(base + (first - _segment_start(segment)), base + offset + 1);
+            _size = first;
+        }
+        _sync();
+    }
+
+    // Destroys the elements and frees every segment.
+    void _free() noexcept {
+        _destroy_from(0);
+        for (size_type k = 0; k < _segments.size(); ++k) {
+            mystd::allocator_traits<allocator_type>::deallocate(_allocator, _segments[k],
+                                                                _segment_size(k));
+        }
+        _segments.clear();
+        _next = _next_end = nullptr;
+    }
+
+    // Copies the elements of other into this empty container, a segment at a time.
+    void _copy_from(const segmented_vector &other) {
+        reserve(other.size());
+        for (size_type k = 0; k < other.segment_count(); ++k) {
+            auto source = other.segment(k);
+            mystd::uninitialized_copy(source.data(), source.data() + source.size(), _segments[k]);
+            _size += source.size();
+        }
+        _sync();
+    }
+
+    // Takes the segments of other, which is left empty, into this container, which must hold no
+    // segments.
+    void _take(segmented_vector &other) noexcept {
+        _segments = mystd::move(other._segments);
+        _size = mystd::exchange(other._size, 0);
+        _next = mystd::exchange(other._next, nullptr);
+        _next_end = mystd::exchange(other._next_end, nullptr);
+    }
+};
+
+template <typename T, typename A>
+struct is_trivially_relocatable<segmented_vector<T, A>> : is_trivially_relocatable<A> {};
+
+template <typename T, typename A>
+auto operator<=>(const segmented_vector<T, A> &lhs, const segmented_vector<T, A> &rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename A>
+bool operator==(const segmented_vector<T, A> &lhs, const segmented_vector<T, A> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    return (lhs <=> rhs) == 0;
+}
+
+template <typename T, typename A>
+void swap(segmented_vector<T, A> &a, segmented_vector<T, A> &b) noexcept {
+    a.swap(b);
+}
+
+} // namespace mystd
@@ -0,0 +1,879 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "bits/growth_policy.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+
+namespace mystd {
+
+// NOTE: A vector that stores up to N elements inline before spilling to the allocator, with the
+// same interface, iterators and exception guarantees as mystd::vector. Moving a small_vector
+// steals its heap block if it has one, and otherwise moves its elements one by one (or with a
+// memcpy if they are trivially relocatable), so moves are only as cheap as N elements are.
+//
+// Iterators into inline storage point into the small_vector itself, so a small_vector is never
+// trivially relocatable.
+template <typename T, std::size_t N, typename A = mystd::allocator<T>,
+          typename Growth = mystd::default_growth>
+class small_vector {
+    static_assert(N > 0, "mystd::small_vector needs room for at least one inline element.");
+
+    [[no_unique_address]] A _allocator{};
+
+    mystd::allocator_traits<A>::pointer _start{};
+    mystd::allocator_traits<A>::pointer _finish{};
+    mystd::allocator_traits<A>::pointer _end_of_storage{};
+
+    alignas(T) unsigned char _buffer[sizeof(T) * N];
+
+public:
+    using value_type = T;
+    using allocator_type = A;
+    using growth_policy = Growth;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = mystd::allocator_traits<allocator_type>::pointer;
+    using const_pointer = mystd::allocator_traits<allocator_type>::const_pointer;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = mystd::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystd::reverse_iterator<const_iterator>;
+
+    static constexpr size_type inline_capacity = N;
+
+    // Construction.
+    small_vector() noexcept(noexcept(allocator_type())) : small_vector(allocator_type()) {}
+
+    explicit small_vector(const allocator_type &allocator) noexcept : _allocator(allocator) {
+        _reset();
+    }
+
+    explicit small_vector(size_type count, const allocator_type &allocator = allocator_type())
+        : small_vector(allocator) {
+        _grow(count);
+
+        mystd::uninitialized_value_construct(_start, _start + count);
+        _finish = _start + count;
+    }
+
+    small_vector(size_type count, const_reference value,
+                 const allocator_type &allocator = allocator_type())
+        : small_vector(allocator) {
+        _grow(count);
+
+        mystd::uninitialized_fill(_start, _start + count, value);
+        _finish = _start + count;
+    }
+
+    // NOTE: The constructors delegating to this one need no cleanup of their own, as the
+    // destructor runs if they throw.
+    template <mystd::input_iterator I>
+    small_vector(I first, I last, const allocator_type &allocator = allocator_type())
+        : small_vector(allocator) {
+        if constexpr (mystd::forward_iterator<I>) {
+            _grow(static_cast<size_type>(mystd::distance(first, last)));
+            _finish = mystd::uninitialized_copy(first, last, _start);
+        } else {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+    }
+
+    small_vector(const small_vector &other)
+        : small_vector(other.begin(), other.end(),
+                       mystd::allocator_traits<allocator_type>::
+                           select_on_container_copy_construction(other._allocator)) {};
+
+    small_vector(const small_vector &other, const allocator_type &allocator)
+        : small_vector(other.begin(), other.end(), allocator) {};
+
+    small_vector(small_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _allocator(std::move(other._allocator)) {
+        _reset();
+        _take(other);
+    }
+
+    small_vector(small_vector &&other, const allocator_type &allocator) : _allocator(allocator) {
+        _reset();
+
+        if (_allocator == other._allocator) {
+            _take(other);
+        } else {
+            _grow(other.size());
+
+            try {
+                _finish = mystd::uninitialized_move(other.begin(), other.end(), _start);
+            } catch (...) {
+                _release();
+                throw;
+            }
+        }
+    }
+
+    small_vector(std::initializer_list<value_type> il,
+                 const allocator_type &allocator = allocator_type())
+        : small_vector(il.begin(), il.end(), allocator) {};
+
+    ~small_vector() {
+        mystd::destroy(begin(), end());
+        _release();
+    }
+
+    small_vector &operator=(const small_vector &other) {
+        if (this != &other) {
+            if constexpr (mystd::allocator_traits<
+                              allocator_type>::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) {
+                    clear();
+                    _release();
+                    _reset();
+                    _allocator = other._allocator;
+                }
+            }
+
+            assign(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    small_vector &operator=(small_vector &&other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        constexpr bool propagate =
+            mystd::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+        clear();
+        if (propagate || _allocator == other._allocator) {
+            _release();
+            _reset();
+
+            if constexpr (propagate) {
+                _allocator = std::move(other._allocator);
+            }
+            _take(other);
+        } else {
+            _grow(other.size());
+
+            if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                          !std::is_copy_constructible_v<T>) {
+                _finish = mystd::uninitialized_move(other.begin(), other.end(), _start);
+            } else {
+                _finish = mystd::uninitialized_copy(other.begin(), other.end(), _start);
+            }
+        }
+
+        return *this;
+    }
+
+    small_vector &operator=(std::initializer_list<value_type> il) {
+        assign(il);
+        return *this;
+    }
+
+    // NOTE: Assignment reuses the existing elements and storage when the new contents fit.
+    void assign(size_type count, const_reference value) {
+        if (count > capacity()) {
+            small_vector temp(count, value, _allocator);
+            swap(temp);
+        } else if (count <= size()) {
+            // The value may be an element, so the tail is only destroyed once it has been read.
+            mystd::fill(begin(), begin() + count, value);
+            mystd::destroy(begin() + count, end());
+            _finish = _start + count;
+        } else {
+            mystd::fill(begin(), end(), value);
+            mystd::uninitialized_fill(end(), _start + count, value);
+            _finish = _start + count;
+        }
+    }
+
+    template <mystd::input_iterator I> void assign(I first, I last) {
+        if constexpr (mystd::forward_iterator<I>) {
+            auto count = static_cast<size_type>(mystd::distance(first, last));
+
+            if (count > capacity()) {
+                small_vector temp(first, last, _allocator);
+                swap(temp);
+            } else if (count <= size()) {
+                iterator new_end = mystd::copy(first, last, begin());
+                mystd::destroy(new_end, end());
+                _finish = new_end;
+            } else {
+                I mid = mystd::next(first, static_cast<difference_type>(size()));
+                mystd::copy(first, mid, begin());
+                _finish = mystd::uninitialized_copy(mid, last, end());
+            }
+        } else {
+            iterator current = begin();
+            for (; first != last && current != end(); ++first, ++current) {
+                *current = *first;
+            }
+
+            if (first == last) {
+                erase(current, end());
+            } else {
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            }
+        }
+    }
+
+    void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
+    // Access.
+    reference operator[](size_type pos) noexcept { return *(_start + pos); }
+    const_reference operator[](size_type pos) const noexcept { return *(_start + pos); }
+
+    reference front() noexcept { return *_start; }
+    const_reference front() const noexcept { return *_start; }
+
+    reference back() noexcept { return *(_finish - 1); }
+    const_reference back() const noexcept { return *(_finish - 1); }
+
+    pointer data() noexcept { return _start; }
+    const_pointer data() const noexcept { return _start; }
+
+    reference at(size_type pos) {
+        if (pos >= size()) {
+            throw std::out_of_range(
+                "mystd::small_vector::at() was called with an index out of bounds.");
+        }
+        return *(_start + pos);
+    }
+    const_reference at(size_type pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range(
+                "mystd::small_vector::at() was called with an index out of bounds.");
+        }
+        return *(_start + pos);
+    }
+
+    allocator_type get_allocator() const noexcept { return _allocator; }
+
+    // Iterators.
+    iterator begin() noexcept { return _start; }
+    const_iterator begin() const noexcept { return _start; }
+    const_iterator cbegin() const noexcept { return _start; }
+
+    iterator end() noexcept { return _finish; }
+    const_iterator end() const noexcept { return _finish; }
+    const_iterator cend() const noexcept { return _finish; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+    // Capacity.
+    bool empty() const noexcept { return _start == _finish; }
+    size_type size() const noexcept { return _finish - _start; }
+    size_type max_size() const noexcept { return std::numeric_limits<size_type>::max(); }
+    size_type capacity() const noexcept { return _end_of_storage - _start; }
+
+    // Whether the elements are stored inline rather than in an allocation.
+    bool is_inline() const noexcept { return _start == _inline(); }
+
+    void reserve(size_type new_cap) {
+        if (new_cap <= capacity()) {
+            return;
+        }
+
+        if (new_cap > max_size()) {
+            throw std::length_error(
+                "mystd::small_vector::reserve() was called with too large a capacity.");
+        }
+
+        _reallocate(new_cap);
+    }
+
+    // NOTE: Moves the elements back inline if they fit.
+    void shrink_to_fit() {
+        if (is_inline() || size() == capacity()) {
+            return;
+        }
+
+        _reallocate(size());
+    }
+
+    // Modifiers.
+    template <typename... Args> iterator emplace(const_iterator cpos, Args &&...args) {
+        auto offset = cpos - cbegin();
+        if (cpos == cend()) {
+            emplace_back(mystd::forward<Args>(args)...);
+            return begin() + offset;
+        }
+
+        // The element is built aside first, as the arguments may refer to elements that growing
+        // and shifting move.
+        if constexpr (_relocatable) {
+            alignas(T) unsigned char buffer[sizeof(T)];
+            auto *element = reinterpret_cast<T *>(buffer);
+            mystd::allocator_traits<allocator_type>::construct(_allocator, element,
+                                                               mystd::forward<Args>(args)...);
+            try {
+                _grow(size() + 1);
+            } catch (...) {
+                mystd::allocator_traits<allocator_type>::destroy(_allocator, element);
+                throw;
+            }
+
+            iterator pos = begin() + offset;
+            _open_gap(pos, 1);
+            mystd::uninitialized_relocate(element, element + 1, pos);
+
+            ++_finish;
+            return pos;
+        } else {
+            value_type value(mystd::forward<Args>(args)...);
+            _grow(size() + 1);
+
+            iterator pos = begin() + offset;
+            mystd::allocator_traits<allocator_type>::construct(_allocator, end(),
+                                                               mystd::move(back()));
+            ++_finish;
+
+            mystd::move_backward(pos, end() - 2, end() - 1);
+            *pos = mystd::move(value);
+            return pos;
+        }
+    }
+
+    template <typename... Args> reference emplace_back(Args &&...args) {
+        if (_finish == _end_of_storage) [[unlikely]] {
+            return _emplace_back_grow(mystd::forward<Args>(args)...);
+        }
+
+        mystd::allocator_traits<allocator_type>::construct(_allocator, _finish,
+                                                           mystd::forward<Args>(args)...);
+        return *_finish++;
+    }
+
+    void push_back(const_reference value) { emplace_back(value); }
+    void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+    // Appends the elements of range, growing once up front if its size is known, as it is for
+    // sized and forward ranges. Other input ranges grow as they are read.
+    template <std::ranges::input_range R>
+        requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+    void append_range(R &&range) {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            _grow(size() + static_cast<size_type>(std::ranges::distance(range)));
+        }
+
+        // Read after growing, so that a vector can append itself.
+        if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R>) {
+            auto *first = std::ranges::data(range);
+            _finish = mystd::uninitialized_copy(first, first + std::ranges::size(range), end());
+        } else {
+            for (auto &&element : range) {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
+        }
+    }
+
+    void pop_back() noexcept {
+        --_finish;
+        mystd::allocator_traits<allocator_type>::destroy(_allocator, _finish);
+    }
+
+    iterator insert(const_iterator cpos, const_reference value) { return emplace(cpos, value); }
+    iterator insert(const_iterator cpos, value_type &&value) {
+        return emplace(cpos, mystd::move(value));
+    }
+
+    iterator insert(const_iterator cpos, size_type count, const_reference value) {
+        difference_type pos_offset = cpos - cbegin();
+        if (count == 0) {
+            return begin() + pos_offset;
+        }
+
+        // The value may be an element, which both reallocation and shifting the tail move.
+        const value_type *source = std::addressof(value);
+        difference_type source_offset = -1;
+        if (source >= _start && source < _finish) {
+            source_offset = source - _start;
+        }
+
+        _grow(size() + count);
+
+        iterator pos = begin() + pos_offset;
+        if (source_offset >= 0) {
+            source = _start + source_offset;
+        }
+
+        if constexpr (_relocatable) {
+            if (source_offset >= pos_offset) {
+                source += count;
+            }
+
+            _open_gap(pos, count);
+            try {
+                mystd::uninitialized_fill(pos, pos + count, *source);
+            } catch (...) {
+                _close_gap(pos, count);
+                throw;
+            }
+
+            _finish += count;
+        } else {
+            // Elements are shifted up by count, moving into the uninitialized storage past end()
+            // first so that _finish always covers exactly the constructed elements.
+            value_type copy = *source;
+            iterator old_end = end();
+            size_type after = old_end - pos;
+
+            if (after > count) {
+                _finish = mystd::uninitialized_move(old_end - count, old_end, old_end);
+                mystd::move_backward(pos, old_end - count, old_end);
+                mystd::fill(pos, pos + count, copy);
+            } else {
+                mystd::uninitialized_fill(old_end, pos + count, copy);
+                _finish = pos + count;
+                _finish = mystd::uninitialized_move(pos, old_end, _finish);
+                mystd::fill(pos, old_end, copy);
+            }
+        }
+
+        return pos;
+    }
+
+    template <mystd::input_iterator I> iterator insert(const_iterator cpos, I first, I last) {
+        difference_type pos_offset = cpos - cbegin();
+
+        if constexpr (mystd::forward_iterator<I>) {
+            size_type count = static_cast<size_type>(mystd::distance(first, last));
+            if (count == 0) {
+                return begin() + pos_offset;
+            }
+
+            _grow(size() + count);
+
+            iterator pos = begin() + pos_offset;
+            if constexpr (_relocatable) {
+                _open_gap(pos, count);
+                try {
+                    mystd::uninitialized_copy(first, last, pos);
+                } catch (...) {
+                    _close_gap(pos, count);
+                    throw;
+                }
+
+                _finish += count;
+            } else {
+                // As in insert(pos, count, value).
+                iterator old_end = end();
+                size_type after = old_end - pos;
+
+                if (after > count) {
+                    _finish = mystd::uninitialized_move(old_end - count, old_end, old_end);
+                    mystd::move_backward(pos, old_end - count, old_end);
+                    mystd::copy(first, last, pos);
+                } else {
+                    I mid = mystd::next(first, static_cast<difference_type>(after));
+                    _finish = mystd::uninitialized_copy(mid, last, old_end);
+                    _finish = mystd::uninitialized_move(pos, old_end, _finish);
+                    mystd::copy(first, mid, pos);
+                }
+            }
+
+            return pos;
+        } else {
+            // A single pass range has to be read before its length is known, so it is appended
+            // and rotated into place.
+            size_type original_size = size();
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+
+            iterator pos = begin() + pos_offset;
+            std::rotate(pos, begin() + original_size, end());
+            return pos;
+        }
+    }
+
+    iterator insert(const_iterator cpos, std::initializer_list<value_type> il) {
+        return insert(cpos, il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator cpos) {
+        iterator pos = begin() + (cpos - cbegin());
+
+        if constexpr (_relocatable) {
+            mystd::allocator_traits<allocator_type>::destroy(_allocator, pos);
+            mystd::uninitialized_relocate(pos + 1, end(), pos);
+        } else {
+            mystd::move(pos + 1, end(), pos);
+            mystd::allocator_traits<allocator_type>::destroy(_allocator, end() - 1);
+        }
+
+        --_finish;
+        return pos;
+    }
+
+    iterator erase(const_iterator cfirst, const_iterator clast) {
+        iterator first = begin() + (cfirst - cbegin());
+        iterator last = begin() + (clast - cbegin());
+
+        if constexpr (_relocatable) {
+            mystd::destroy(first, last);
+            _finish = mystd::uninitialized_relocate(last, end(), first);
+        } else {
+            auto new_end = mystd::move(last, end(), first);
+            mystd::destroy(new_end, end());
+
+            _finish = new_end;
+        }
+
+        return first;
+    }
+
+    // Removes the element at pos in constant time by moving the last element into its place, so
+    // the order of the other elements is not preserved. Returns an iterator to the element now at
+    // pos, which is end() if pos was the last element.
+    iterator swap_remove(const_iterator cpos) {
+        iterator pos = begin() + (cpos - cbegin());
+        iterator last = end() - 1;
+
+        if (pos != last) {
+            if constexpr (_relocatable) {
+                mystd::allocator_traits<allocator_type>::destroy(_allocator, pos);
+                mystd::uninitialized_relocate(last, end(), pos);
+
+                --_finish;
+                return pos;
+            } else {
+                *pos = mystd::move(*last);
+            }
+        }
+
+        pop_back();
+        return pos;
+    }
+
+    void clear() {
+        mystd::destroy(begin(), end());
+        _finish = _start;
+    }
+
+    void resize(size_type count, const_reference value) {
+        iterator new_end = _start + count;
+
+        if (count < size()) {
+            mystd::destroy(new_end, end());
+        } else if (count > size()) {
+            _grow(count);
+
+            new_end = _start + count;
+            mystd::uninitialized_fill(end(), new_end, value);
+        }
+
+        _finish = new_end;
+    }
+    void resize(size_type count) { resize(count, value_type{}); }
+
+    // NOTE: Like resize(), but new elements are default-initialized, so trivially default
+    // constructible ones are left for the caller to overwrite rather than being zeroed first.
+    void resize_for_overwrite(size_type count) {
+        if (count < size()) {
+            mystd::destroy(_start + count, end());
+        } else if (count > size()) {
+            _grow(count);
+            mystd::uninitialized_default_construct(end(), _start + count);
+        }
+
+        _finish = _start + count;
+    }
+
+    // Makes room for count more elements and calls writer(end(), count) to fill the raw storage
+    // after the last element, e.g. with read(). The writer returns how many elements it wrote, at
+    // most count, and only those are appended. Returns that number.
+    template <std::invocable<pointer, size_type> Writer>
+        requires std::is_trivially_default_constructible_v<T> &&
+                 std::is_trivially_destructible_v<T>
+    size_type append_uninitialized(size_type count, Writer writer) {
+        _grow(size() + count);
+
+        size_type written = std::min<size_type>(writer(end(), count), count);
+        _finish += written;
+        return written;
+    }
+
+    // NOTE: It is UB to call swap() on containers with different allocators. Two heap blocks are
+    // swapped in constant time, but inline elements have to be moved.
+    void swap(small_vector &other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if constexpr (mystd::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+            mystd::swap(_allocator, other._allocator);
+        }
+
+        if (!is_inline() && !other.is_inline()) {
+            mystd::swap(_start, other._start);
+            mystd::swap(_finish, other._finish);
+            mystd::swap(_end_of_storage, other._end_of_storage);
+            return;
+        }
+
+        small_vector temp(mystd::move(other));
+        other._take(*this);
+        _take(temp);
+    }
+
+private:
+    // NOTE: Trivially relocatable elements are moved between inline and heap storage, reallocated
+    // and shifted with memmove rather than element by element, which also cannot throw.
+    static constexpr bool _relocatable =
+        mystd::is_trivially_relocatable_v<T> && std::is_pointer_v<pointer>;
+
+    pointer _inline() noexcept { return reinterpret_cast<pointer>(_buffer); }
+    const_pointer _inline() const noexcept { return reinterpret_cast<const_pointer>(_buffer); }
+
+    // Points at empty inline storage, forgetting any elements or allocation.
+    void _reset() noexcept {
+        _start = _finish = _inline();
+        _end_of_storage = _start + N;
+    }
+
+    // Frees the allocation, if any. The elements must already be destroyed or moved out.
+    void _release() noexcept {
+        if (!is_inline()) {
+            mystd::allocator_traits<allocator_type>::deallocate(_allocator, _start, capacity());
+        }
+    }
+
+    // Takes the elements of other, which is left empty and inline, into this empty and inline
+    // vector. Heap blocks are stolen, and inline elements are moved across.
+    void _take(small_vector &other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (!other.is_inline()) {
+            _start = other._start;
+            _finish = other._finish;
+            _end_of_storage = other._end_of_storage;
+        } else if constexpr (_relocatable) {
+            _finish = mystd::uninitialized_relocate(other._start, other._finish, _start);
+        } else {
+            _finish = mystd::uninitialized_move(other.begin(), other.end(), _start);
+            mystd::destroy(other.begin(), other.end());
+        }
+
+        other._reset();
+    }
+
+    // The capacity to grow to for at least required elements, as the growth policy dictates.
+    size_type _next_capacity(size_type required) const {
+        if (required > max_size()) {
+            throw std::length_error("mystd::small_vector grew beyond max_size().");
+        }
+
+        return std::max(required, Growth::next_capacity(capacity(), required, sizeof(T)));
+    }
+
+    // Makes room for at least required elements.
+    void _grow(size_type required) {
+        if (required <= capacity()) {
+            return;
+        }
+
+        _reallocate(_next_capacity(required));
+    }
+
+    // Moves the elements into new storage and ends their lifetimes, returning the end of the new
+    // elements. They are copied instead if moving could throw and copying cannot, so that on
+    // failure the originals are left as they were.
+    pointer _transfer(pointer new_start) {
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            return mystd::uninitialized_relocate(_start, _finish, new_start);
+        } else {
+            pointer new_finish;
+            if constexpr (!std::is_copy_constructible_v<T>) {
+                new_finish = mystd::uninitialized_move(begin(), end(), new_start);
+            } else {
+                new_finish = mystd::uninitialized_copy(begin(), end(), new_start);
+            }
+
+            mystd::destroy(begin(), end());
+            return new_finish;
+        }
+    }
+
+    // NOTE: As in mystd::vector, heap blocks are first expanded in place and then reallocated
+    // bitwise where possible. Capacities of at most N move the elements back inline.
+    void _reallocate(size_type new_cap) {
+        using traits = mystd::allocator_traits<allocator_type>;
+
+        bool to_inline = new_cap <= N;
+        if (to_inline && is_inline()) {
+            return;
+        }
+
+        if (!to_inline && !is_inline()) {
+            if (new_cap > capacity() &&
+                traits::try_expand(_allocator, _start, capacity(), new_cap)) {
+                _end_of_storage = _start + new_cap;
+                return;
+            }
+
+            if constexpr (_relocatable) {
+                size_type count = size();
+
+                _start = traits::reallocate(_allocator, _start, capacity(), new_cap);
+                _finish = _start + count;
+                _end_of_storage = _start + new_cap;
+                return;
+            }
+        }
+
+        if (to_inline) {
+            new_cap = N;
+        }
+
+        pointer new_start = to_inline ? _inline() : traits::allocate(_allocator, new_cap);
+        pointer new_finish = new_start;
+
+        if constexpr (_relocatable) {
+            new_finish = mystd::uninitialized_relocate(_start, _finish, new_start);
+        } else {
+            try {
+                new_finish = _transfer(new_start);
+            } catch (...) {
+                if (!to_inline) {
+                    traits::deallocate(_allocator, new_start, new_cap);
+                }
+                throw;
+            }
+        }
+
+        _release();
+
+        _start = new_start;
+        _finish = new_finish;
+        _end_of_storage = new_start + new_cap;
+    }
+
+    // The slow path of emplace_back(), kept out of line so that the fast path stays small enough
+    // to inline. The arguments may refer to elements, so the new element is constructed before
+    // the old ones move: aside and then relocated in if it is trivially relocatable, and otherwise
+    // directly in the new storage.
+    template <typename... Args> [[gnu::noinline]] reference _emplace_back_grow(Args &&...args) {
+        using traits = mystd::allocator_traits<allocator_type>;
+        size_type new_cap = _next_capacity(size() + 1);
+
+        if constexpr (_relocatable) {
+            alignas(T) unsigned char buffer[sizeof(T)];
+            auto *element = reinterpret_cast<T *>(buffer);
+            traits::construct(_allocator, element, mystd::forward<Args>(args)...);
+            try {
+                _reallocate(new_cap);
+            } catch (...) {
+                traits::destroy(_allocator, element);
+                throw;
+            }
+
+            mystd::uninitialized_relocate(element, element + 1, _finish);
+            return *_finish++;
+        }
+
+        if (!is_inline() && traits::try_expand(_allocator, _start, capacity(), new_cap)) {
+            _end_of_storage = _start + new_cap;
+            traits::construct(_allocator, _finish, mystd::forward<Args>(args)...);
+            return *_finish++;
+        }
+
+        pointer new_start = traits::allocate(_allocator, new_cap);
+        pointer slot = new_start + size();
+        try {
+            traits::construct(_allocator, slot, mystd::forward<Args>(args)...);
+        } catch (...) {
+            traits::deallocate(_allocator, new_start, new_cap);
+            throw;
+        }
+
+        try {
+            _transfer(new_start);
+        } catch (...) {
+            traits::destroy(_allocator, slot);
+            traits::deallocate(_allocator, new_start, new_cap);
+            throw;
+        }
+
+        _release();
+
+        _start = new_start;
+        _finish = slot + 1;
+        _end_of_storage = new_start + new_cap;
+        return *slot;
+    }
+
+    // Shifts [pos, end()) up by count, leaving [pos, pos + count) uninitialized.
+    void _open_gap(iterator pos, size_type count) noexcept {
+        mystd::uninitialized_relocate(pos, end(), pos + count);
+    }
+
+    // Undoes _open_gap() before _finish has been advanced.
+    void _close_gap(iterator pos, size_type count) noexcept {
+        mystd::uninitialized_relocate(pos + count, end() + count, pos);
+    }
+};
+
+template <typename T, std::size_t N, typename A, typename G>
+auto operator<=>(const small_vector<T, N, A, G> &lhs, const small_vector<T, N, A, G> &rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, std::size_t N, typename A, typename G>
+bool operator==(const small_vector<T, N, A, G> &lhs, const small_vector<T, N, A, G> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    return (lhs <=> rhs) == 0;
+}
+
+template <typename T, std::size_t N, typename A, typename G>
+void swap(small_vector<T, N, A, G> &a,
+          small_vector<T, N, A, G> &b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+// See erase_if() for mystd::vector.
+template <typename T, std::size_t N, typename A, typename G, typename Pred>
+typename small_vector<T, N, A, G>::size_type erase_if(small_vector<T, N, A, G> &c, Pred pred) {
+    auto out = std::find_if(c.begin(), c.end(), pred);
+    if (out == c.end()) {
+        return 0;
+    }
+
+    for (auto it = out + 1; it != c.end(); ++it) {
+        if (!pred(*it)) {
+            *out++ = mystd::move(*it);
+        }
+    }
+
+    auto removed = static_cast<typename small_vector<T, N, A, G>::size_type>(c.end() - out);
+    c.erase(out, c.end());
+    return removed;
+}
+
+template <typename T, std::size_t N, typename A, typename G, typename U>
+typename small_vector<T, N, A, G>::size_type erase(small_vector<T, N, A, G> &c, const U &value) {
+    return mystd::erase_if(c, [&value](const T &element) { return element == value; });
+}
+
+} // namespace mystd
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace mystd {
 
@@ -29,4 +31,20 @@ template <typename T> struct remove_reference<T &&> {
 };
 template <typename T> using remove_reference_t = remove_reference<T>::type;
 
+// NOTE: A type is trivially relocatable if moving an object to a new address and ending the
+// lifetime of the original is equivalent to copying its bytes and forgetting the original.
+// Trivially copyable types always are; other types opt in by specialising this trait. std::string
+// must not: libstdc++'s short-string buffer is addressed by a pointer into the object itself.
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+template <typename T>
+constexpr inline bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+template <typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+template <typename T, typename U>
+struct is_trivially_relocatable<std::pair<T, U>>
+    : std::bool_constant<is_trivially_relocatable_v<T> && is_trivially_relocatable_v<U>> {};
+
 } // namespace mystd
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "bits/hashtable.hpp"
+#include "bits/hash_engine.hpp"
 
 #include "utility.hpp"
 
@@ -11,8 +11,10 @@ namespace mystd {
 
 template <typename K, typename V, typename Hash> class unordered_multimap;
 
-template <typename K, typename V, typename Hash = std::hash<K>> class unordered_map {
-    using _hashtable = detail::hashtable<std::pair<K, V>, detail::key_extractor_first, Hash, true>;
+template <typename K, typename V, typename Hash = std::hash<K>, typename Engine = chained_hashing>
+class unordered_map {
+    using _hashtable =
+        typename Engine::template table<std::pair<K, V>, detail::key_extractor_first, Hash, true>;
     _hashtable _table;
 
     template <typename, typename, typename> friend class unordered_multimap;
@@ -26,6 +28,9 @@ public:
     using const_iterator = typename _hashtable::const_iterator;
     using local_iterator = typename _hashtable::local_iterator;
     using const_local_iterator = typename _hashtable::const_local_iterator;
+    using bucket_range = typename _hashtable::bucket_range;
+    using const_bucket_range = typename _hashtable::const_bucket_range;
+    using hashed_key_type = typename _hashtable::hashed_key_type;
 
     unordered_map() = default;
     unordered_map(size_type count) : _table(count) {}
@@ -58,14 +63,18 @@ public:
     iterator erase(iterator pos) { return _table.erase(pos); }
     iterator erase(const_iterator first, const_iterator last) { return _table.erase(first, last); }
     size_type erase(const key_type &key) { return _table.erase(key); }
+    size_type erase(const hashed_key_type &hk) { return _table.erase(hk); }
 
     void swap(unordered_map &other) noexcept { return _table.swap(other._table); }
 
-    template <typename H> void merge(unordered_map<K, V, H> &other) {
+    template <typename H> void merge(unordered_map<K, V, H, Engine> &other) {
         return _table.merge(other._table);
     }
 
-    template <typename H> void merge(unordered_multimap<K, V, H> &other) {
+    template <typename H>
+    void merge(unordered_multimap<K, V, H> &other)
+        requires std::same_as<Engine, chained_hashing>
+    {
         return _table.merge(other._table);
     }
 
@@ -74,10 +83,14 @@ public:
     // Lookup.
     iterator find(const key_type &key) noexcept { return _table.find(key); }
     const_iterator find(const key_type &key) const noexcept { return _table.find(key); }
+    iterator find(const hashed_key_type &hk) noexcept { return _table.find(hk); }
+    const_iterator find(const hashed_key_type &hk) const noexcept { return _table.find(hk); }
 
     bool contains(const key_type &key) const noexcept { return _table.contains(key); }
+    bool contains(const hashed_key_type &hk) const noexcept { return _table.contains(hk); }
 
     size_type count(const key_type &key) const noexcept { return _table.count(key); }
+    size_type count(const hashed_key_type &hk) const noexcept { return _table.count(hk); }
 
     std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
         return _table.equal_range(key);
@@ -85,6 +98,13 @@ public:
     std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const noexcept {
         return _table.equal_range(key);
     }
+    std::pair<iterator, iterator> equal_range(const hashed_key_type &hk) noexcept {
+        return _table.equal_range(hk);
+    }
+    std::pair<const_iterator, const_iterator>
+    equal_range(const hashed_key_type &hk) const noexcept {
+        return _table.equal_range(hk);
+    }
 
     value_type::second_type &operator[](const key_type &key) {
         auto [it, _] = emplace(key, typename value_type::second_type{});
@@ -122,14 +142,33 @@ public:
     size_type bucket_count() const noexcept { return _table.bucket_count(); }
     size_type max_bucket_count() const noexcept { return _table.max_bucket_count(); }
     size_type bucket(const key_type &key) const noexcept { return _table.bucket(key); }
+    size_type bucket(const hashed_key_type &hk) const noexcept { return _table.bucket(hk); }
     size_type bucket_size(size_type bucket) const noexcept { return _table.bucket_size(bucket); }
 
+    // Parallel iteration.
+    mystd::vector<bucket_range> bucket_ranges(size_type count) {
+        return _table.bucket_ranges(count);
+    }
+    mystd::vector<const_bucket_range> bucket_ranges(size_type count) const {
+        return _table.bucket_ranges(count);
+    }
+
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) {
+        _table.for_each_parallel(mystd::move(fn), threads);
+    }
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) const {
+        _table.for_each_parallel(mystd::move(fn), threads);
+    }
+
     // Hashing.
     float load_factor() const noexcept { return _table.load_factor(); }
     float max_load_factor() const noexcept { return _table.max_load_factor(); }
     void max_load_factor(float ml) noexcept { _table.max_load_factor(ml); }
     void rehash(size_type count) { _table.rehash(count); }
     void reserve(size_type count) { _table.reserve(count); }
+    template <mystd::forward_iterator I> void reserve_estimated(I first, I last) {
+        _table.reserve_estimated(first, last);
+    }
 };
 
 } // namespace mystd
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "bits/hashtable.hpp"
+#include "bits/hash_engine.hpp"
 
 #include "utility.hpp"
 
@@ -8,13 +8,13 @@
 
 namespace mystd {
 
-template <typename K, typename Hash> class unordered_set;
+template <typename K, typename Hash, typename Engine> class unordered_set;
 
 template <typename K, typename Hash = std::hash<K>> class unordered_multiset {
     using _hashtable = detail::hashtable<K, detail::key_extractor_identity, Hash, false>;
     _hashtable _table;
 
-    template <typename, typename> friend class unordered_set;
+    template <typename, typename, typename> friend class unordered_set;
 
 public:
     using key_type = typename _hashtable::key_type;
@@ -24,6 +24,9 @@ public:
     using const_iterator = typename _hashtable::const_iterator;
     using local_iterator = typename _hashtable::local_iterator;
     using const_local_iterator = typename _hashtable::const_local_iterator;
+    using bucket_range = typename _hashtable::bucket_range;
+    using const_bucket_range = typename _hashtable::const_bucket_range;
+    using hashed_key_type = typename _hashtable::hashed_key_type;
 
     unordered_multiset() = default;
     unordered_multiset(size_type count) : _table(count) {}
@@ -60,10 +63,11 @@ public:
     }
     iterator erase(const_iterator first, const_iterator last) { return _table.erase(first, last); }
     size_type erase(const key_type &key) { return _table.erase(key); }
+    size_type erase(const hashed_key_type &hk) { return _table.erase(hk); }
 
     void swap(unordered_multiset &other) noexcept { return _table.swap(other._table); }
 
-    template <typename H> void merge(unordered_set<K, H> &other) {
+    template <typename H> void merge(unordered_set<K, H, chained_hashing> &other) {
         return _table.merge(other._table);
     }
 
@@ -76,10 +80,14 @@ public:
     // Lookup.
     iterator find(const key_type &key) noexcept { return _table.find(key); }
     const_iterator find(const key_type &key) const noexcept { return _table.find(key); }
+    iterator find(const hashed_key_type &hk) noexcept { return _table.find(hk); }
+    const_iterator find(const hashed_key_type &hk) const noexcept { return _table.find(hk); }
 
     bool contains(const key_type &key) const noexcept { return _table.contains(key); }
+    bool contains(const hashed_key_type &hk) const noexcept { return _table.contains(hk); }
 
     size_type count(const key_type &key) const noexcept { return _table.count(key); }
+    size_type count(const hashed_key_type &hk) const noexcept { return _table.count(hk); }
 
     std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
         return _table.equal_range(key);
@@ -87,6 +95,13 @@ public:
     std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const noexcept {
         return _table.equal_range(key);
     }
+    std::pair<iterator, iterator> equal_range(const hashed_key_type &hk) noexcept {
+        return _table.equal_range(hk);
+    }
+    std::pair<const_iterator, const_iterator>
+    equal_range(const hashed_key_type &hk) const noexcept {
+        return _table.equal_range(hk);
+    }
 
     // Buckets.
     local_iterator begin(size_type bucket) noexcept { return _table.begin(bucket); }
@@ -100,8 +115,24 @@ public:
     size_type bucket_count() const noexcept { return _table.bucket_count(); }
     size_type max_bucket_count() const noexcept { return _table.max_bucket_count(); }
     size_type bucket(const key_type &key) const noexcept { return _table.bucket(key); }
+    size_type bucket(const hashed_key_type &hk) const noexcept { return _table.bucket(hk); }
     size_type bucket_size(size_type bucket) const noexcept { return _table.bucket_size(bucket); }
 
+    // Parallel iteration.
+    mystd::vector<bucket_range> bucket_ranges(size_type count) {
+        return _table.bucket_ranges(count);
+    }
+    mystd::vector<const_bucket_range> bucket_ranges(size_type count) const {
+        return _table.bucket_ranges(count);
+    }
+
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) {
+        _table.for_each_parallel(mystd::move(fn), threads);
+    }
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) const {
+        _table.for_each_parallel(mystd::move(fn), threads);
+    }
+
     // Hashing.
     float load_factor() const noexcept { return _table.load_factor(); }
     float max_load_factor() const noexcept { return _table.max_load_factor(); }
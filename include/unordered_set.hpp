@@ -1,6 +1,6 @@
 #pragma once
 
-#include "bits/hashtable.hpp"
+#include "bits/hash_engine.hpp"
 
 #include "utility.hpp"
 
@@ -10,8 +10,10 @@ namespace mystd {
 
 template <typename K, typename Hash> class unordered_multiset;
 
-template <typename K, typename Hash = std::hash<K>> class unordered_set {
-    using _hashtable = detail::hashtable<K, detail::key_extractor_identity, Hash, true>;
+template <typename K, typename Hash = std::hash<K>, typename Engine = chained_hashing>
+class unordered_set {
+    using _hashtable =
+        typename Engine::template table<K, detail::key_extractor_identity, Hash, true>;
     _hashtable _table;
 
     template <typename, typename> friend class unordered_multiset;
@@ -24,6 +26,9 @@ public:
     using const_iterator = typename _hashtable::const_iterator;
     using local_iterator = typename _hashtable::local_iterator;
     using const_local_iterator = typename _hashtable::const_local_iterator;
+    using bucket_range = typename _hashtable::bucket_range;
+    using const_bucket_range = typename _hashtable::const_bucket_range;
+    using hashed_key_type = typename _hashtable::hashed_key_type;
 
     unordered_set() = default;
     unordered_set(size_type count) : _table(count) {}
@@ -60,14 +65,18 @@ public:
     }
     iterator erase(const_iterator first, const_iterator last) { return _table.erase(first, last); }
     size_type erase(const key_type &key) { return _table.erase(key); }
+    size_type erase(const hashed_key_type &hk) { return _table.erase(hk); }
 
     void swap(unordered_set &other) noexcept { return _table.swap(other._table); }
 
-    template <typename H> void merge(unordered_set<K, H> &other) {
+    template <typename H> void merge(unordered_set<K, H, Engine> &other) {
         return _table.merge(other._table);
     }
 
-    template <typename H> void merge(unordered_multiset<K, H> &other) {
+    template <typename H>
+    void merge(unordered_multiset<K, H> &other)
+        requires std::same_as<Engine, chained_hashing>
+    {
         return _table.merge(other._table);
     }
 
@@ -76,10 +85,14 @@ public:
     // Lookup.
     iterator find(const key_type &key) noexcept { return _table.find(key); }
     const_iterator find(const key_type &key) const noexcept { return _table.find(key); }
+    iterator find(const hashed_key_type &hk) noexcept { return _table.find(hk); }
+    const_iterator find(const hashed_key_type &hk) const noexcept { return _table.find(hk); }
 
     bool contains(const key_type &key) const noexcept { return _table.contains(key); }
+    bool contains(const hashed_key_type &hk) const noexcept { return _table.contains(hk); }
 
     size_type count(const key_type &key) const noexcept { return _table.count(key); }
+    size_type count(const hashed_key_type &hk) const noexcept { return _table.count(hk); }
 
     std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
         return _table.equal_range(key);
@@ -87,6 +100,13 @@ public:
     std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const noexcept {
         return _table.equal_range(key);
     }
+    std::pair<iterator, iterator> equal_range(const hashed_key_type &hk) noexcept {
+        return _table.equal_range(hk);
+    }
+    std::pair<const_iterator, const_iterator>
+    equal_range(const hashed_key_type &hk) const noexcept {
+        return _table.equal_range(hk);
+    }
 
     // Buckets.
     local_iterator begin(size_type bucket) noexcept { return _table.begin(bucket); }
@@ -100,14 +120,33 @@ public:
     size_type bucket_count() const noexcept { return _table.bucket_count(); }
     size_type max_bucket_count() const noexcept { return _table.max_bucket_count(); }
     size_type bucket(const key_type &key) const noexcept { return _table.bucket(key); }
+    size_type bucket(const hashed_key_type &hk) const noexcept { return _table.bucket(hk); }
     size_type bucket_size(size_type bucket) const noexcept { return _table.bucket_size(bucket); }
 
+    // Parallel iteration.
+    mystd::vector<bucket_range> bucket_ranges(size_type count) {
+        return _table.bucket_ranges(count);
+    }
+    mystd::vector<const_bucket_range> bucket_ranges(size_type count) const {
+        return _table.bucket_ranges(count);
+    }
+
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) {
+        _table.for_each_parallel(mystd::move(fn), threads);
+    }
+    template <typename Fn> void for_each_parallel(Fn fn, size_type threads) const {
+        _table.for_each_parallel(mystd::move(fn), threads);
+    }
+
     // Hashing.
     float load_factor() const noexcept { return _table.load_factor(); }
     float max_load_factor() const noexcept { return _table.max_load_factor(); }
     void max_load_factor(float ml) noexcept { _table.max_load_factor(ml); }
     void rehash(size_type count) { _table.rehash(count); }
     void reserve(size_type count) { _table.reserve(count); }
+    template <mystd::forward_iterator I> void reserve_estimated(I first, I last) {
+        _table.reserve_estimated(first, last);
+    }
 };
 
 } // namespace mystd
@@ -0,0 +1,292 @@
+#pragma once
+
+#include "bits/index_table.hpp"
+#include "bits/iterator_base_types.hpp"
+#include "bits/iterator_concepts.hpp"
+#include "vector.hpp"
+
+#include "utility.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mystd {
+
+template <typename K, typename V, typename Hash> class unordered_split_map;
+
+namespace detail {
+
+template <typename K> struct split_key_slot {
+    std::size_t hash{};
+    K key{};
+};
+
+// A pair of references standing in for value_type &, since the key and value are not adjacent.
+template <typename K, typename V> struct split_reference {
+    const K &first;
+    V &second;
+
+    operator std::pair<K, std::remove_const_t<V>>() const { return {first, second}; }
+};
+
+template <typename K, typename V, bool IsConst = false> class split_iterator {
+    template <typename, typename, bool> friend class split_iterator;
+    template <typename, typename, typename> friend class mystd::unordered_split_map;
+
+    using _mapped_type = std::conditional_t<IsConst, const V, V>;
+
+    const split_key_slot<K> *_key{};
+    _mapped_type *_value{};
+
+public:
+    using iterator_category = mystd::forward_iterator_tag;
+    using value_type = std::pair<K, V>;
+    using reference = split_reference<K, _mapped_type>;
+    using difference_type = std::ptrdiff_t;
+
+    struct pointer {
+        reference ref;
+        const reference *operator->() const noexcept { return &ref; }
+    };
+
+    split_iterator() = default;
+    split_iterator(const split_key_slot<K> *key, _mapped_type *value) : _key(key), _value(value) {}
+    template <bool OtherConst>
+    split_iterator(const split_iterator<K, V, OtherConst> &other)
+        requires(IsConst || !OtherConst)
+        : _key(other._key), _value(other._value) {}
+
+    split_iterator &operator++() noexcept {
+        ++_key;
+        ++_value;
+        return *this;
+    }
+
+    split_iterator operator++(int) noexcept {
+        split_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    reference operator*() const noexcept { return {_key->key, *_value}; }
+    pointer operator->() const noexcept { return {**this}; }
+
+    template <bool OtherConst>
+    friend bool operator==(const split_iterator &lhs, const split_iterator<K, V, OtherConst> &rhs) {
+        return lhs._key == rhs._key;
+    }
+};
+
+} // namespace detail
+
+// NOTE: Stores keys (with their cached hashes) and values in separate contiguous arrays, so a
+// lookup only touches key memory until the caller reads the value. Dereferencing an iterator
+// yields a split_reference proxy with first/second members rather than a value_type &, so bind
+// elements with `auto [k, v]` or `auto &&[k, v]`. As with index_map, erase() moves the last
+// element into the erased position and any insertion or erasure invalidates iterators.
+template <typename K, typename V, typename Hash = std::hash<K>> class unordered_split_map {
+    using _key_slot = detail::split_key_slot<K>;
+    using _index_type = detail::slot_index::index_type;
+
+    mystd::vector<_key_slot> _keys;
+    mystd::vector<V> _values;
+    detail::slot_index _index;
+
+    Hash _hash{};
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = std::size_t;
+    using iterator = detail::split_iterator<K, V, false>;
+    using const_iterator = detail::split_iterator<K, V, true>;
+    using reference = typename iterator::reference;
+    using const_reference = typename const_iterator::reference;
+
+    unordered_split_map() = default;
+
+    // Iterators.
+    iterator begin() noexcept { return iterator(_keys.begin(), _values.begin()); }
+    const_iterator begin() const noexcept { return const_iterator(_keys.begin(), _values.begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(_keys.end(), _values.end()); }
+    const_iterator end() const noexcept { return const_iterator(_keys.end(), _values.end()); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Capacity.
+    bool empty() const noexcept { return _keys.empty(); }
+    size_type size() const noexcept { return _keys.size(); }
+    size_type max_size() const noexcept { return detail::slot_index::max_entries; }
+
+    void reserve(size_type count) {
+        _keys.reserve(count);
+        _values.reserve(count);
+
+        if (_index.needs_growth(count)) {
+            _index.rebuild(size(), count, [this](size_type i) { return _keys[i].hash; });
+        }
+    }
+
+    // Modifiers.
+    template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+        value_type data(mystd::forward<Args>(args)...);
+        size_type hash = _hash(data.first);
+
+        if (auto index = _find(data.first, hash); index != detail::slot_index::npos) {
+            return {_at(index), false};
+        }
+
+        return {_insert(hash, mystd::move(data.first), mystd::move(data.second)), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value) { return emplace(value); }
+    std::pair<iterator, bool> insert(value_type &&value) { return emplace(mystd::move(value)); }
+
+    template <mystd::input_iterator I> void insert(I first, I last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+    void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+
+    iterator erase(const_iterator pos) {
+        auto index = static_cast<_index_type>(pos._key - _keys.begin());
+        auto last = static_cast<_index_type>(size() - 1);
+
+        _index.erase(_keys[index].hash, index, [this](size_type i) { return _keys[i].hash; });
+
+        if (index != last) {
+            _keys[index] = mystd::move(_keys[last]);
+            _values[index] = mystd::move(_values[last]);
+            _index.replace(_keys[index].hash, last, index);
+        }
+
+        _keys.pop_back();
+        _values.pop_back();
+
+        return _at(index);
+    }
+
+    size_type erase(const key_type &key) {
+        auto index = _find(key, _hash(key));
+        if (index == detail::slot_index::npos) {
+            return 0;
+        }
+
+        erase(_at(index));
+        return 1;
+    }
+
+    void swap(unordered_split_map &other) noexcept {
+        _keys.swap(other._keys);
+        _values.swap(other._values);
+        _index.swap(other._index);
+        mystd::swap(_hash, other._hash);
+    }
+
+    void clear() noexcept {
+        _keys.clear();
+        _values.clear();
+        _index.clear();
+    }
+
+    // Lookup.
+    iterator find(const key_type &key) noexcept {
+        auto index = _find(key, _hash(key));
+        return index == detail::slot_index::npos ? end() : _at(index);
+    }
+
+    const_iterator find(const key_type &key) const noexcept {
+        return const_cast<unordered_split_map *>(this)->find(key);
+    }
+
+    bool contains(const key_type &key) const noexcept {
+        return _find(key, _hash(key)) != detail::slot_index::npos;
+    }
+
+    size_type count(const key_type &key) const noexcept { return contains(key) ? 1 : 0; }
+
+    std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
+        auto first = find(key);
+        return {first, first == end() ? end() : mystd::next(first)};
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const noexcept {
+        auto [first, last] = const_cast<unordered_split_map *>(this)->equal_range(key);
+        return {first, last};
+    }
+
+    // NOTE: The key is probed first, so a hit neither copies the key nor builds a mapped_type.
+    mapped_type &operator[](const key_type &key) {
+        size_type hash = _hash(key);
+        if (auto index = _find(key, hash); index != detail::slot_index::npos) {
+            return _values[index];
+        }
+
+        _insert(hash, key_type(key), mapped_type{});
+        return _values.back();
+    }
+
+    mapped_type &operator[](key_type &&key) {
+        size_type hash = _hash(key);
+        if (auto index = _find(key, hash); index != detail::slot_index::npos) {
+            return _values[index];
+        }
+
+        _insert(hash, mystd::move(key), mapped_type{});
+        return _values.back();
+    }
+
+    mapped_type &at(const key_type &key) {
+        auto index = _find(key, _hash(key));
+        if (index == detail::slot_index::npos) {
+            throw std::out_of_range(
+                "mystd::unordered_split_map::at() was called with a non-existent key.");
+        }
+
+        return _values[index];
+    }
+
+    const mapped_type &at(const key_type &key) const {
+        return const_cast<unordered_split_map *>(this)->at(key);
+    }
+
+private:
+    iterator _at(size_type index) noexcept {
+        return iterator(_keys.begin() + index, _values.begin() + index);
+    }
+
+    // Appends a key known to be absent.
+    iterator _insert(size_type hash, key_type &&key, mapped_type &&value) {
+        if (size() >= max_size()) {
+            throw std::length_error("mystd::unordered_split_map::emplace() exceeded max_size().");
+        }
+        if (_index.needs_growth(size())) {
+            _index.rebuild(size(), size() + 1, [this](size_type i) { return _keys[i].hash; });
+        }
+
+        _values.push_back(mystd::move(value));
+        try {
+            _keys.push_back(_key_slot{hash, mystd::move(key)});
+        } catch (...) {
+            _values.pop_back();
+            throw;
+        }
+
+        _index.insert(hash, static_cast<_index_type>(size() - 1));
+        return _at(size() - 1);
+    }
+
+    _index_type _find(const key_type &key, size_type hash) const noexcept {
+        return _index.find(hash, [&](_index_type i) {
+            return _keys[i].hash == hash && _keys[i].key == key;
+        });
+    }
+};
+
+} // namespace mystd
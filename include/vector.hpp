@@ -1,20 +1,25 @@
 #pragma once
 
 #include "algorithm.hpp"
+#include "bits/growth_policy.hpp"
 #include "iterator.hpp"
 #include "memory.hpp"
 #include "utility.hpp"
 
 #include <algorithm>
+#include <concepts>
 #include <cstddef>
 #include <initializer_list>
 #include <limits>
+#include <ranges>
 #include <stdexcept>
 
 namespace mystd {
 
-// TODO: Add assign() and redefine methods in terms of it.
-template <typename T, typename A = mystd::allocator<T>> class vector {
+// NOTE: Growth decides the capacity to grow to when an insertion runs out of room (see
+// bits/growth_policy.hpp); reserve() always allocates exactly what it is asked for.
+template <typename T, typename A = mystd::allocator<T>, typename Growth = mystd::default_growth>
+class vector {
     [[no_unique_address]] A _allocator{};
 
     mystd::allocator_traits<A>::pointer _start{};
@@ -24,6 +29,7 @@ template <typename T, typename A = mystd::allocator<T>> class vector {
 public:
     using value_type = T;
     using allocator_type = A;
+    using growth_policy = Growth;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using reference = T &;
@@ -46,7 +52,7 @@ public:
         _end_of_storage = _start + count;
 
         try {
-            mystd::uninitialized_default_construct(_start, _end_of_storage);
+            mystd::uninitialized_value_construct(_start, _end_of_storage);
             _finish = _end_of_storage;
         } catch (...) {
             mystd::allocator_traits<allocator_type>::deallocate(_allocator, _start, count);
@@ -151,21 +157,7 @@ public:
                 }
             }
 
-            if (other.size() > capacity()) {
-                vector temp(other, _allocator);
-                swap(temp);
-            } else {
-                size_type common_size = std::min(size(), other.size());
-                mystd::copy(other.begin(), other.begin() + common_size, begin());
-
-                if (size() > common_size) {
-                    mystd::destroy(begin() + common_size, end());
-                } else if (other.size() > common_size) {
-                    mystd::uninitialized_copy(other.begin() + common_size, other.end(), end());
-                }
-
-                _finish = _start + other.size();
-            }
+            assign(other.begin(), other.end());
         }
 
         return *this;
@@ -195,10 +187,61 @@ public:
     }
 
     vector &operator=(std::initializer_list<value_type> il) {
-        *this = vector(il);
+        assign(il);
         return *this;
     }
 
+    // NOTE: Assignment reuses the existing elements and storage when the new contents fit.
+    void assign(size_type count, const_reference value) {
+        if (count > capacity()) {
+            vector temp(count, value, _allocator);
+            swap(temp);
+        } else if (count <= size()) {
+            // The value may be an element, so the tail is only destroyed once it has been read.
+            mystd::fill(begin(), begin() + count, value);
+            mystd::destroy(begin() + count, end());
+            _finish = _start + count;
+        } else {
+            mystd::fill(begin(), end(), value);
+            mystd::uninitialized_fill(end(), _start + count, value);
+            _finish = _start + count;
+        }
+    }
+
+    template <mystd::input_iterator I> void assign(I first, I last) {
+        if constexpr (mystd::forward_iterator<I>) {
+            auto count = static_cast<size_type>(mystd::distance(first, last));
+
+            if (count > capacity()) {
+                vector temp(first, last, _allocator);
+                swap(temp);
+            } else if (count <= size()) {
+                iterator new_end = mystd::copy(first, last, begin());
+                mystd::destroy(new_end, end());
+                _finish = new_end;
+            } else {
+                I mid = mystd::next(first, static_cast<difference_type>(size()));
+                mystd::copy(first, mid, begin());
+                _finish = mystd::uninitialized_copy(mid, last, end());
+            }
+        } else {
+            iterator current = begin();
+            for (; first != last && current != end(); ++first, ++current) {
+                *current = *first;
+            }
+
+            if (first == last) {
+                erase(current, end());
+            } else {
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            }
+        }
+    }
+
+    void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
     // Access.
     reference operator[](size_type pos) noexcept { return *(_start + pos); }
     const_reference operator[](size_type pos) const noexcept { return *(_start + pos); }
@@ -260,29 +303,7 @@ public:
                 "mystd::vector::reserve() was called with too large a capacity.");
         }
 
-        pointer new_start = mystd::allocator_traits<allocator_type>::allocate(_allocator, new_cap);
-        pointer new_finish = new_start;
-
-        try {
-            if constexpr (std::is_nothrow_move_constructible_v<T> ||
-                          !std::is_copy_constructible_v<T>) {
-                new_finish = mystd::uninitialized_move(begin(), end(), new_start);
-            } else {
-                new_finish = mystd::uninitialized_copy(begin(), end(), new_start);
-            }
-
-            mystd::destroy(begin(), end());
-            if (_start) {
-                mystd::allocator_traits<allocator_type>::deallocate(_allocator, _start, capacity());
-            }
-
-            _start = new_start;
-            _finish = new_finish;
-            _end_of_storage = new_start + new_cap;
-        } catch (...) {
-            mystd::allocator_traits<allocator_type>::deallocate(_allocator, new_start, new_cap);
-            throw;
-        }
+        _reallocate(new_cap);
     }
 
     void shrink_to_fit() {
@@ -290,55 +311,85 @@ public:
             return;
         }
 
-        pointer new_start = mystd::allocator_traits<allocator_type>::allocate(_allocator, size());
-        pointer new_finish = new_start;
-
-        try {
-            if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
-                          !std::is_copy_constructible_v<value_type>) {
-                new_finish = mystd::uninitialized_move(begin(), end(), new_start);
-            } else {
-                new_finish = mystd::uninitialized_copy(begin(), end(), new_start);
-            }
-
-            mystd::destroy(begin(), end());
-            if (_start) {
-                mystd::allocator_traits<allocator_type>::deallocate(_allocator, _start, capacity());
-            }
-
-            _start = new_start;
-            _finish = new_finish;
-            _end_of_storage = new_start + size();
-        } catch (...) {
-            mystd::allocator_traits<allocator_type>::deallocate(_allocator, new_start, size());
-            throw;
-        }
+        _reallocate(size());
     }
 
     // Modifiers.
     template <typename... Args> iterator emplace(const_iterator cpos, Args &&...args) {
-        auto offset = mystd::distance(cbegin(), cpos);
-        if (size() == capacity()) {
-            reserve(size() == 0 ? 1 : 2 * size());
+        auto offset = cpos - cbegin();
+        if (cpos == cend()) {
+            emplace_back(mystd::forward<Args>(args)...);
+            return begin() + offset;
         }
 
-        iterator pos = begin() + offset;
+        // The element is built aside first, as the arguments may refer to elements that growing
+        // and shifting move.
+        if constexpr (_relocatable) {
+            alignas(T) unsigned char buffer[sizeof(T)];
+            auto *element = reinterpret_cast<T *>(buffer);
+            mystd::allocator_traits<allocator_type>::construct(_allocator, element,
+                                                               mystd::forward<Args>(args)...);
+            try {
+                _grow(size() + 1);
+            } catch (...) {
+                mystd::allocator_traits<allocator_type>::destroy(_allocator, element);
+                throw;
+            }
 
-        mystd::allocator_traits<allocator_type>::construct(_allocator, end(),
-                                                           mystd::forward<Args>(args)...);
-        std::rotate(pos, end(), end() + 1);
+            iterator pos = begin() + offset;
+            _open_gap(pos, 1);
+            mystd::uninitialized_relocate(element, element + 1, pos);
 
-        ++_finish;
-        return pos;
+            ++_finish;
+            return pos;
+        } else {
+            value_type value(mystd::forward<Args>(args)...);
+            _grow(size() + 1);
+
+            iterator pos = begin() + offset;
+            mystd::allocator_traits<allocator_type>::construct(_allocator, end(),
+                                                               mystd::move(back()));
+            ++_finish;
+
+            mystd::move_backward(pos, end() - 2, end() - 1);
+            *pos = mystd::move(value);
+            return pos;
+        }
     }
 
     template <typename... Args> reference emplace_back(Args &&...args) {
-        return *emplace(cend(), mystd::forward<Args>(args)...);
+        if (_finish == _end_of_storage) [[unlikely]] {
+            return _emplace_back_grow(mystd::forward<Args>(args)...);
+        }
+
+        mystd::allocator_traits<allocator_type>::construct(_allocator, _finish,
+                                                           mystd::forward<Args>(args)...);
+        return *_finish++;
     }
 
     void push_back(const_reference value) { emplace_back(value); }
     void push_back(value_type &&value) { emplace_back(std::move(value)); }
 
+    // Appends the elements of range, growing once up front if its size is known, as it is for
+    // sized and forward ranges. Other input ranges grow as they are read.
+    template <std::ranges::input_range R>
+        requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+    void append_range(R &&range) {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            _grow(size() + static_cast<size_type>(std::ranges::distance(range)));
+        }
+
+        // Read after growing, so that a vector can append itself.
+        if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R>) {
+            auto *first = std::ranges::data(range);
+            _finish = mystd::uninitialized_copy(first, first + std::ranges::size(range), end());
+        } else {
+            for (auto &&element : range) {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
+        }
+    }
+
     void pop_back() noexcept {
         --_finish;
         mystd::allocator_traits<allocator_type>::destroy(_allocator, _finish);
@@ -351,37 +402,112 @@ public:
 
     iterator insert(const_iterator cpos, size_type count, const_reference value) {
         difference_type pos_offset = cpos - cbegin();
-        reserve(size() + count);
+        if (count == 0) {
+            return begin() + pos_offset;
+        }
+
+        // The value may be an element, which both reallocation and shifting the tail move.
+        const value_type *source = std::addressof(value);
+        difference_type source_offset = -1;
+        if (source >= _start && source < _finish) {
+            source_offset = source - _start;
+        }
+
+        _grow(size() + count);
 
         iterator pos = begin() + pos_offset;
+        if (source_offset >= 0) {
+            source = _start + source_offset;
+        }
 
-        mystd::uninitialized_fill(end(), end() + count, value);
-        std::rotate(pos, end(), end() + count);
+        if constexpr (_relocatable) {
+            if (source_offset >= pos_offset) {
+                source += count;
+            }
+
+            _open_gap(pos, count);
+            try {
+                mystd::uninitialized_fill(pos, pos + count, *source);
+            } catch (...) {
+                _close_gap(pos, count);
+                throw;
+            }
+
+            _finish += count;
+        } else {
+            // Elements are shifted up by count, moving into the uninitialized storage past end()
+            // first so that _finish always covers exactly the constructed elements.
+            value_type copy = *source;
+            iterator old_end = end();
+            size_type after = old_end - pos;
+
+            if (after > count) {
+                _finish = mystd::uninitialized_move(old_end - count, old_end, old_end);
+                mystd::move_backward(pos, old_end - count, old_end);
+                mystd::fill(pos, pos + count, copy);
+            } else {
+                mystd::uninitialized_fill(old_end, pos + count, copy);
+                _finish = pos + count;
+                _finish = mystd::uninitialized_move(pos, old_end, _finish);
+                mystd::fill(pos, old_end, copy);
+            }
+        }
 
-        _finish += count;
         return pos;
     }
 
     template <mystd::input_iterator I> iterator insert(const_iterator cpos, I first, I last) {
         difference_type pos_offset = cpos - cbegin();
-        size_type original_size = size();
 
         if constexpr (mystd::forward_iterator<I>) {
-            size_type count = static_cast<size_type>(std::distance(first, last));
-            reserve(size() + count);
+            size_type count = static_cast<size_type>(mystd::distance(first, last));
+            if (count == 0) {
+                return begin() + pos_offset;
+            }
 
-            mystd::uninitialized_copy(first, last, end());
-            _finish += count;
+            _grow(size() + count);
+
+            iterator pos = begin() + pos_offset;
+            if constexpr (_relocatable) {
+                _open_gap(pos, count);
+                try {
+                    mystd::uninitialized_copy(first, last, pos);
+                } catch (...) {
+                    _close_gap(pos, count);
+                    throw;
+                }
+
+                _finish += count;
+            } else {
+                // As in insert(pos, count, value).
+                iterator old_end = end();
+                size_type after = old_end - pos;
+
+                if (after > count) {
+                    _finish = mystd::uninitialized_move(old_end - count, old_end, old_end);
+                    mystd::move_backward(pos, old_end - count, old_end);
+                    mystd::copy(first, last, pos);
+                } else {
+                    I mid = mystd::next(first, static_cast<difference_type>(after));
+                    _finish = mystd::uninitialized_copy(mid, last, old_end);
+                    _finish = mystd::uninitialized_move(pos, old_end, _finish);
+                    mystd::copy(first, mid, pos);
+                }
+            }
+
+            return pos;
         } else {
+            // A single pass range has to be read before its length is known, so it is appended
+            // and rotated into place.
+            size_type original_size = size();
             for (; first != last; ++first) {
-                push_back(*first);
+                emplace_back(*first);
             }
-        }
-
-        iterator pos = begin() + pos_offset;
-        std::rotate(pos, begin() + original_size, end());
 
-        return pos;
+            iterator pos = begin() + pos_offset;
+            std::rotate(pos, begin() + original_size, end());
+            return pos;
+        }
     }
 
     iterator insert(const_iterator cpos, std::initializer_list<value_type> il) {
@@ -391,8 +517,13 @@ public:
     iterator erase(const_iterator cpos) {
         iterator pos = begin() + (cpos - cbegin());
 
-        mystd::move(pos + 1, end(), pos);
-        mystd::allocator_traits<allocator_type>::destroy(_allocator, end() - 1);
+        if constexpr (_relocatable) {
+            mystd::allocator_traits<allocator_type>::destroy(_allocator, pos);
+            mystd::uninitialized_relocate(pos + 1, end(), pos);
+        } else {
+            mystd::move(pos + 1, end(), pos);
+            mystd::allocator_traits<allocator_type>::destroy(_allocator, end() - 1);
+        }
 
         --_finish;
         return pos;
@@ -402,13 +533,42 @@ public:
         iterator first = begin() + (cfirst - cbegin());
         iterator last = begin() + (clast - cbegin());
 
-        auto new_end = mystd::move(last, end(), first);
-        mystd::destroy(new_end, end());
+        if constexpr (_relocatable) {
+            mystd::destroy(first, last);
+            _finish = mystd::uninitialized_relocate(last, end(), first);
+        } else {
+            auto new_end = mystd::move(last, end(), first);
+            mystd::destroy(new_end, end());
+
+            _finish = new_end;
+        }
 
-        _finish = new_end;
         return first;
     }
 
+    // Removes the element at pos in constant time by moving the last element into its place, so
+    // the order of the other elements is not preserved. Returns an iterator to the element now at
+    // pos, which is end() if pos was the last element.
+    iterator swap_remove(const_iterator cpos) {
+        iterator pos = begin() + (cpos - cbegin());
+        iterator last = end() - 1;
+
+        if (pos != last) {
+            if constexpr (_relocatable) {
+                mystd::allocator_traits<allocator_type>::destroy(_allocator, pos);
+                mystd::uninitialized_relocate(last, end(), pos);
+
+                --_finish;
+                return pos;
+            } else {
+                *pos = mystd::move(*last);
+            }
+        }
+
+        pop_back();
+        return pos;
+    }
+
     void clear() {
         mystd::destroy(begin(), end());
         _finish = _start;
@@ -420,7 +580,7 @@ public:
         if (count < size()) {
             mystd::destroy(new_end, end());
         } else if (count > size()) {
-            reserve(count);
+            _grow(count);
 
             new_end = _start + count;
             mystd::uninitialized_fill(end(), new_end, value);
@@ -430,6 +590,33 @@ public:
     }
     void resize(size_type count) { resize(count, value_type{}); }
 
+    // NOTE: Like resize(), but new elements are default-initialized, so trivially default
+    // constructible ones are left for the caller to overwrite rather than being zeroed first.
+    void resize_for_overwrite(size_type count) {
+        if (count < size()) {
+            mystd::destroy(_start + count, end());
+        } else if (count > size()) {
+            _grow(count);
+            mystd::uninitialized_default_construct(end(), _start + count);
+        }
+
+        _finish = _start + count;
+    }
+
+    // Makes room for count more elements and calls writer(end(), count) to fill the raw storage
+    // after the last element, e.g. with read(). The writer returns how many elements it wrote, at
+    // most count, and only those are appended. Returns that number.
+    template <std::invocable<pointer, size_type> Writer>
+        requires std::is_trivially_default_constructible_v<T> &&
+                 std::is_trivially_destructible_v<T>
+    size_type append_uninitialized(size_type count, Writer writer) {
+        _grow(size() + count);
+
+        size_type written = std::min<size_type>(writer(end(), count), count);
+        _finish += written;
+        return written;
+    }
+
     // NOTE: It is UB to call swap() on containers with different allocators.
     void swap(vector &other) noexcept {
         if constexpr (mystd::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
@@ -440,15 +627,174 @@ public:
         mystd::swap(_finish, other._finish);
         mystd::swap(_end_of_storage, other._end_of_storage);
     }
+
+private:
+    // NOTE: Trivially relocatable elements are reallocated and shifted with memmove rather than
+    // element by element, which also cannot throw.
+    static constexpr bool _relocatable =
+        mystd::is_trivially_relocatable_v<T> && std::is_pointer_v<pointer>;
+
+    // The capacity to grow to for at least required elements, as the growth policy dictates.
+    size_type _next_capacity(size_type required) const {
+        if (required > max_size()) {
+            throw std::length_error("mystd::vector grew beyond max_size().");
+        }
+
+        return std::max(required, Growth::next_capacity(capacity(), required, sizeof(T)));
+    }
+
+    // Makes room for at least required elements.
+    void _grow(size_type required) {
+        if (required <= capacity()) {
+            return;
+        }
+
+        _reallocate(_next_capacity(required));
+    }
+
+    // Moves the elements into new storage and ends their lifetimes, returning the end of the new
+    // elements. They are copied instead if moving could throw and copying cannot, so that on
+    // failure the originals are left as they were.
+    pointer _transfer(pointer new_start) {
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            return mystd::uninitialized_relocate(_start, _finish, new_start);
+        } else {
+            pointer new_finish;
+            if constexpr (!std::is_copy_constructible_v<T>) {
+                new_finish = mystd::uninitialized_move(begin(), end(), new_start);
+            } else {
+                new_finish = mystd::uninitialized_copy(begin(), end(), new_start);
+            }
+
+            mystd::destroy(begin(), end());
+            return new_finish;
+        }
+    }
+
+    // NOTE: Growth first asks the allocator to extend the block in place, which never moves the
+    // elements. Failing that, trivially relocatable elements are moved by the allocator's
+    // reallocate() (realloc() for mystd::allocator), and anything else is moved element by
+    // element into a fresh block before the old one is freed.
+    void _reallocate(size_type new_cap) {
+        using traits = mystd::allocator_traits<allocator_type>;
+
+        if (_start && new_cap > capacity() &&
+            traits::try_expand(_allocator, _start, capacity(), new_cap)) {
+            _end_of_storage = _start + new_cap;
+            return;
+        }
+
+        if constexpr (_relocatable) {
+            if (_start && new_cap != 0) {
+                size_type count = size();
+
+                _start = traits::reallocate(_allocator, _start, capacity(), new_cap);
+                _finish = _start + count;
+                _end_of_storage = _start + new_cap;
+                return;
+            }
+        }
+
+        pointer new_start = mystd::allocator_traits<allocator_type>::allocate(_allocator, new_cap);
+        pointer new_finish = new_start;
+
+        if constexpr (_relocatable) {
+            new_finish = mystd::uninitialized_relocate(_start, _finish, new_start);
+        } else {
+            try {
+                new_finish = _transfer(new_start);
+            } catch (...) {
+                mystd::allocator_traits<allocator_type>::deallocate(_allocator, new_start, new_cap);
+                throw;
+            }
+        }
+
+        if (_start) {
+            mystd::allocator_traits<allocator_type>::deallocate(_allocator, _start, capacity());
+        }
+
+        _start = new_start;
+        _finish = new_finish;
+        _end_of_storage = new_start + new_cap;
+    }
+
+    // The slow path of emplace_back(), kept out of line so that the fast path stays small enough
+    // to inline. The arguments may refer to elements, so the new element is constructed before
+    // the old ones move: aside and then relocated in if it is trivially relocatable, and otherwise
+    // directly in the new storage.
+    template <typename... Args> [[gnu::noinline]] reference _emplace_back_grow(Args &&...args) {
+        using traits = mystd::allocator_traits<allocator_type>;
+        size_type new_cap = _next_capacity(size() + 1);
+
+        if constexpr (_relocatable) {
+            alignas(T) unsigned char buffer[sizeof(T)];
+            auto *element = reinterpret_cast<T *>(buffer);
+            traits::construct(_allocator, element, mystd::forward<Args>(args)...);
+            try {
+                _reallocate(new_cap);
+            } catch (...) {
+                traits::destroy(_allocator, element);
+                throw;
+            }
+
+            mystd::uninitialized_relocate(element, element + 1, _finish);
+            return *_finish++;
+        }
+
+        if (_start && traits::try_expand(_allocator, _start, capacity(), new_cap)) {
+            _end_of_storage = _start + new_cap;
+            traits::construct(_allocator, _finish, mystd::forward<Args>(args)...);
+            return *_finish++;
+        }
+
+        pointer new_start = traits::allocate(_allocator, new_cap);
+        pointer slot = new_start + size();
+        try {
+            traits::construct(_allocator, slot, mystd::forward<Args>(args)...);
+        } catch (...) {
+            traits::deallocate(_allocator, new_start, new_cap);
+            throw;
+        }
+
+        try {
+            _transfer(new_start);
+        } catch (...) {
+            traits::destroy(_allocator, slot);
+            traits::deallocate(_allocator, new_start, new_cap);
+            throw;
+        }
+
+        if (_start) {
+            traits::deallocate(_allocator, _start, capacity());
+        }
+
+        _start = new_start;
+        _finish = slot + 1;
+        _end_of_storage = new_start + new_cap;
+        return *slot;
+    }
+
+    // Shifts [pos, end()) up by count, leaving [pos, pos + count) uninitialized.
+    void _open_gap(iterator pos, size_type count) noexcept {
+        mystd::uninitialized_relocate(pos, end(), pos + count);
+    }
+
+    // Undoes _open_gap() before _finish has been advanced.
+    void _close_gap(iterator pos, size_type count) noexcept {
+        mystd::uninitialized_relocate(pos + count, end() + count, pos);
+    }
 };
 
-template <typename T, typename A>
-auto operator<=>(const vector<T, A> &lhs, const vector<T, A> &rhs) {
+template <typename T, typename A, typename G>
+struct is_trivially_relocatable<vector<T, A, G>> : is_trivially_relocatable<A> {};
+
+template <typename T, typename A, typename G>
+auto operator<=>(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
     return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, typename A>
-bool operator==(const vector<T, A> &lhs, const vector<T, A> &rhs) {
+template <typename T, typename A, typename G>
+bool operator==(const vector<T, A, G> &lhs, const vector<T, A, G> &rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
@@ -456,6 +802,33 @@ bool operator==(const vector<T, A> &lhs, const vector<T, A> &rhs) {
     return (lhs <=> rhs) == 0;
 }
 
-template <typename T, typename A> void swap(vector<T, A> &a, vector<T, A> &b) { a.swap(b); }
+template <typename T, typename A, typename G> void swap(vector<T, A, G> &a, vector<T, A, G> &b) {
+    a.swap(b);
+}
+
+// Removes the elements matching pred in a single pass that moves each kept element at most once,
+// returning how many were removed.
+template <typename T, typename A, typename G, typename Pred>
+typename vector<T, A, G>::size_type erase_if(vector<T, A, G> &c, Pred pred) {
+    auto out = std::find_if(c.begin(), c.end(), pred);
+    if (out == c.end()) {
+        return 0;
+    }
+
+    for (auto it = out + 1; it != c.end(); ++it) {
+        if (!pred(*it)) {
+            *out++ = mystd::move(*it);
+        }
+    }
+
+    auto removed = static_cast<typename vector<T, A, G>::size_type>(c.end() - out);
+    c.erase(out, c.end());
+    return removed;
+}
+
+template <typename T, typename A, typename G, typename U>
+typename vector<T, A, G>::size_type erase(vector<T, A, G> &c, const U &value) {
+    return mystd::erase_if(c, [&value](const T &element) { return element == value; });
+}
 
 } // namespace mystd
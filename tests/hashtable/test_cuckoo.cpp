@@ -0,0 +1,263 @@
+#include "bits/cuckoo_table.hpp"
+#include "bits/iterator_concepts.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+using cuckoo_table =
+    mystd::detail::cuckoo_table<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                std::hash<int>>;
+
+using string_cuckoo_table =
+    mystd::detail::cuckoo_table<std::string, mystd::detail::key_extractor_identity,
+                                std::hash<std::string>>;
+
+TEST(CuckooTable, IteratorConcept) {
+    EXPECT_TRUE((mystd::forward_iterator<cuckoo_table::iterator>));
+    EXPECT_TRUE((mystd::forward_iterator<cuckoo_table::const_iterator>));
+    EXPECT_TRUE((mystd::forward_iterator<cuckoo_table::local_iterator>));
+}
+
+TEST(CuckooTable, EmplaceAndFind) {
+    cuckoo_table table;
+    EXPECT_EQ(table.find(1), table.end());
+
+    auto [it, inserted] = table.emplace(1, 10);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->second, 10);
+
+    auto [existing, reinserted] = table.emplace(1, 20);
+    EXPECT_FALSE(reinserted);
+    EXPECT_EQ(existing, it);
+    EXPECT_EQ(existing->second, 10);
+
+    EXPECT_TRUE(table.contains(1));
+    EXPECT_EQ(table.count(2), 0);
+    EXPECT_EQ(table.size(), 1);
+}
+
+TEST(CuckooTable, HighLoadFactor) {
+    cuckoo_table table;
+    table.max_load_factor(0.95f);
+
+    // Displacement paths and the stash keep the table near full without growing.
+    table.rehash(256);
+    size_t capacity = 4 * table.bucket_count();
+    int count = static_cast<int>(0.95 * capacity);
+    for (int i = 0; i < count; ++i) {
+        table.emplace(i * 7919, i);
+    }
+
+    EXPECT_EQ(table.size(), static_cast<size_t>(count));
+    EXPECT_EQ(table.bucket_count(), 256);
+    EXPECT_LE(table.load_factor(), 0.95f);
+    for (int i = 0; i < count; ++i) {
+        auto it = table.find(i * 7919);
+        ASSERT_NE(it, table.end()) << i;
+        EXPECT_EQ(it->second, i);
+    }
+
+    size_t visited = 0;
+    for (auto it = table.begin(); it != table.end(); ++it) {
+        ++visited;
+    }
+    EXPECT_EQ(visited, table.size());
+
+    size_t in_buckets = 0;
+    for (size_t b = 0; b < table.bucket_count(); ++b) {
+        EXPECT_LE(table.bucket_size(b), 4);
+        in_buckets += table.bucket_size(b);
+    }
+    EXPECT_LE(in_buckets, table.size());
+    EXPECT_GE(in_buckets + 8, table.size());
+}
+
+TEST(CuckooTable, EraseAgainstReference) {
+    cuckoo_table table;
+    std::unordered_map<int, int> expected;
+
+    for (int i = 0; i < 3000; ++i) {
+        int key = (i * 37) % 1009;
+        if (i % 3 == 2) {
+            EXPECT_EQ(table.erase(key), expected.erase(key));
+        } else {
+            EXPECT_EQ(table.emplace(key, i).second, expected.emplace(key, i).second);
+        }
+    }
+
+    EXPECT_EQ(table.size(), expected.size());
+    for (int key = 0; key < 1009; ++key) {
+        auto it = table.find(key);
+        if (expected.contains(key)) {
+            ASSERT_NE(it, table.end());
+            EXPECT_EQ(it->second, expected[key]);
+        } else {
+            EXPECT_EQ(it, table.end());
+        }
+    }
+
+    auto it = table.erase(table.begin(), table.end());
+    EXPECT_EQ(it, table.end());
+    EXPECT_TRUE(table.empty());
+}
+
+TEST(CuckooTable, CollidingHashesUseTheStash) {
+    struct ConstantHash {
+        size_t operator()(int) const noexcept { return 0; }
+    };
+    mystd::detail::cuckoo_table<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                ConstantHash>
+        table;
+
+    // All keys share both buckets, so after eight slots they spill into the stash.
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_TRUE(table.emplace(i, i).second);
+    }
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_TRUE(table.contains(i)) << i;
+    }
+
+    EXPECT_EQ(table.erase(11), 1);
+    EXPECT_EQ(table.erase(0), 1);
+    EXPECT_EQ(table.size(), 10);
+
+    size_t visited = 0;
+    for (const auto &kv : table) {
+        EXPECT_TRUE(kv.first > 0 && kv.first < 11);
+        ++visited;
+    }
+    EXPECT_EQ(visited, 10);
+}
+
+TEST(CuckooTable, FullHashCollisionsOverflowTheStash) {
+    struct ConstantHash {
+        size_t operator()(int) const noexcept { return 0; }
+    };
+    mystd::detail::cuckoo_table<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                ConstantHash>
+        table;
+
+    // No seed separates these keys, so the stash grows rather than the table.
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(table.emplace(i, i).second) << i;
+    }
+    EXPECT_EQ(table.size(), 200);
+    EXPECT_LE(table.bucket_count(), 256);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(table.contains(i)) << i;
+    }
+}
+
+TEST(CuckooTable, ThrowingCopyDuringRehashKeepsElements) {
+    static int copies_left;
+    struct ThrowingCopy {
+        int value;
+
+        ThrowingCopy(int v) : value(v) {}
+        ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+            if (--copies_left < 0) {
+                throw std::runtime_error("copy");
+            }
+        }
+        ThrowingCopy(ThrowingCopy &&other) noexcept(false) : value(other.value) {}
+    };
+    mystd::detail::cuckoo_table<std::pair<int, ThrowingCopy>,
+                                mystd::detail::key_extractor_first, std::hash<int>>
+        table;
+
+    copies_left = 1000;
+    for (int i = 0; i < 100; ++i) {
+        table.emplace(i, ThrowingCopy(i));
+    }
+
+    copies_left = 10;
+    EXPECT_THROW(table.rehash(4 * table.bucket_count()), std::runtime_error);
+    EXPECT_EQ(table.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        auto it = table.find(i);
+        ASSERT_NE(it, table.end()) << i;
+        EXPECT_EQ(it->second.value, i);
+    }
+}
+
+TEST(CuckooTable, CopyMoveAndSwap) {
+    string_cuckoo_table table;
+    for (int i = 0; i < 100; ++i) {
+        table.emplace(std::to_string(i));
+    }
+
+    string_cuckoo_table copy(table);
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_EQ(copy.seed(), table.seed());
+    EXPECT_TRUE(copy.contains("42"));
+
+    string_cuckoo_table moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 100);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(copy.contains("42"));
+
+    string_cuckoo_table other;
+    other.emplace("x");
+    other.swap(moved);
+    EXPECT_EQ(other.size(), 100);
+    EXPECT_TRUE(moved.contains("x"));
+
+    copy = table;
+    EXPECT_TRUE(copy.contains("99"));
+}
+
+TEST(CuckooTable, Merge) {
+    cuckoo_table table;
+    cuckoo_table other;
+
+    table.emplace(1, 1);
+    other.emplace(1, 2);
+    other.emplace(2, 2);
+
+    table.merge(other);
+    EXPECT_EQ(table.size(), 2);
+    EXPECT_EQ(table.find(1)->second, 1);
+    EXPECT_EQ(other.size(), 1);
+    EXPECT_TRUE(other.contains(1));
+}
+
+TEST(CuckooTable, HashedKey) {
+    string_cuckoo_table table;
+    std::string key = "key";
+    string_cuckoo_table::hashed_key_type hk(key);
+
+    EXPECT_TRUE(table.emplace(hk).second);
+    EXPECT_FALSE(table.emplace(hk).second);
+    EXPECT_TRUE(table.contains(hk));
+    EXPECT_EQ(table.bucket(hk), table.bucket(key));
+    EXPECT_EQ(table.erase(hk), 1);
+    EXPECT_TRUE(table.empty());
+}
+
+TEST(CuckooTable, BucketRanges) {
+    mystd::detail::cuckoo_table<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                std::hash<int>>
+        table;
+    EXPECT_EQ(table.bucket_ranges(4).size(), 1);
+
+    for (int i = 0; i < 1000; ++i) {
+        table.emplace(i, i);
+    }
+
+    size_t visited = 0;
+    for (const auto &range : table.bucket_ranges(5)) {
+        for (const auto &kv : range) {
+            EXPECT_EQ(kv.first, kv.second);
+            ++visited;
+        }
+    }
+    EXPECT_EQ(visited, 1000);
+
+    std::atomic<long> sum{0};
+    table.for_each_parallel([&](const std::pair<int, int> &kv) { sum += kv.first; }, 4);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
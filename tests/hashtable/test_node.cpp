@@ -3,6 +3,11 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 TEST(HashtableNode, IteratorConcept) {
     EXPECT_TRUE((mystd::forward_iterator<mystd::detail::node_iterator<int, false>>));
     EXPECT_TRUE((mystd::forward_iterator<mystd::detail::node_iterator<int, true>>));
@@ -60,7 +65,8 @@ TEST(HashtableNode, LocalIteratorTraversal) {
     mystd::detail::node<Wrapper> n2{.next = &n3, .hash = 1, .data = Wrapper{.v = 2}};
     mystd::detail::node<Wrapper> n1{.next = &n2, .hash = 1, .data = Wrapper{.v = 1}};
 
-    auto it = mystd::detail::local_node_iterator(&n1, 1, 2);
+    // Two buckets, so the mask is 1.
+    auto it = mystd::detail::local_node_iterator(&n1, 1, 1);
 
     EXPECT_EQ((*it).v, 1);
     EXPECT_EQ(it->v, 1);
@@ -73,3 +79,46 @@ TEST(HashtableNode, LocalIteratorTraversal) {
     auto end = mystd::detail::local_node_iterator<Wrapper>();
     EXPECT_EQ(++it, end);
 }
+
+TEST(HashtableNode, BucketIteratorTraversal) {
+    // Two buckets laid out as the hashtable would: bucket 0 holds n1 and bucket 1 holds n2, n3.
+    mystd::detail::node<int> n3{.hash = 3, .data = 3};
+    mystd::detail::node<int> n2{.next = &n3, .hash = 1, .data = 2};
+    mystd::detail::node<int> n1{.next = &n2, .hash = 2, .data = 1};
+    mystd::detail::node<int> before_begin{.next = &n1};
+
+    mystd::detail::node_bucket<int> buckets[2]{};
+    buckets[0].before = &before_begin;
+    buckets[1].before = &n1;
+
+    std::vector<int> all;
+    for (auto it = mystd::detail::bucket_node_iterator<int>(buckets, 0, 2, 1);
+         it != mystd::detail::bucket_node_iterator<int>(); ++it) {
+        all.push_back(*it);
+    }
+    EXPECT_EQ(all, (std::vector<int>{1, 2, 3}));
+
+    mystd::detail::bucket_node_iterator<int, true> second(buckets, 1, 2, 1);
+    EXPECT_EQ(*second, 2);
+    EXPECT_EQ(*++second, 3);
+    EXPECT_EQ(++second, (mystd::detail::bucket_node_iterator<int, true>()));
+}
+
+TEST(HashtableNode, KeyPrefix) {
+    using traits = mystd::detail::key_traits<std::string>;
+
+    // Only string keys carry an inline prefix.
+    EXPECT_EQ(sizeof(mystd::detail::node<long>), 3 * sizeof(long));
+    EXPECT_EQ(sizeof(mystd::detail::node_key_prefix_t<std::pair<std::string, int>>), 16);
+
+    auto short_key = traits::prefix("abc");
+    EXPECT_TRUE(traits::decisive(short_key));
+    EXPECT_TRUE(traits::equal(short_key, traits::prefix("abc")));
+    EXPECT_FALSE(traits::equal(short_key, traits::prefix(std::string_view("abc\0", 4))));
+    EXPECT_FALSE(traits::equal(short_key, traits::prefix("abd")));
+
+    auto long_key = traits::prefix("0123456789abcdef-one");
+    EXPECT_FALSE(traits::decisive(long_key));
+    EXPECT_TRUE(traits::equal(long_key, traits::prefix("0123456789abcdef-two")));
+    EXPECT_TRUE(traits::decisive(traits::prefix("0123456789abcde")));
+}
@@ -1,9 +1,14 @@
 #include "bits/hashtable.hpp"
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 using unique_table =
     mystd::detail::hashtable<std::pair<const char *, int>, mystd::detail::key_extractor_first,
@@ -288,3 +293,488 @@ TEST(Hashtable, CommonRehash) {
     EXPECT_EQ(seen.size(), 3);
     EXPECT_EQ(sum, 1 + 2 + 3);
 }
+
+TEST(Hashtable, CommonSmallTable) {
+    unique_table ut;
+    EXPECT_EQ(ut.bucket_count(), 1);
+
+    // Stays bucketless while small, regardless of the load factor.
+    std::array<const char *, 9> keys{"a", "b", "c", "d", "e", "f", "g", "h", "i"};
+    for (size_t i = 0; i < 8; ++i) {
+        ut.emplace(keys[i], static_cast<int>(i));
+    }
+    EXPECT_EQ(ut.bucket_count(), 1);
+    EXPECT_EQ(ut.bucket_size(0), 8);
+    EXPECT_NE(ut.find("c"), ut.end());
+    EXPECT_EQ(ut.find("NA"), ut.end());
+
+    ut.emplace(keys[8], 8);
+    EXPECT_GT(ut.bucket_count(), 1);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto it = ut.find(keys[i]);
+        ASSERT_NE(it, ut.end());
+        EXPECT_EQ(it->second, static_cast<int>(i));
+    }
+}
+
+TEST(Hashtable, CommonSmallTableSwap) {
+    unique_table small, large(32);
+    small.insert({{"a", 1}, {"b", 2}});
+    large.insert({{"c", 3}, {"d", 4}, {"e", 5}});
+
+    small.swap(large);
+    EXPECT_EQ(small.bucket_count(), 32);
+    EXPECT_EQ(large.bucket_count(), 1);
+
+    EXPECT_NE(small.find("c"), small.end());
+    EXPECT_NE(large.find("a"), large.end());
+
+    // Both tables remain usable after the swap.
+    small.emplace("f", 6);
+    large.emplace("g", 7);
+    EXPECT_EQ(small.size(), 4);
+    EXPECT_EQ(large.size(), 3);
+    EXPECT_NE(large.find("g"), large.end());
+
+    unique_table empty;
+    empty.swap(large);
+    EXPECT_EQ(empty.size(), 3);
+    EXPECT_TRUE(large.empty());
+    EXPECT_EQ(large.begin(), large.end());
+}
+
+TEST(Hashtable, CommonCopy) {
+    unique_table ut(4);
+    ut.max_load_factor(1000);
+    ut.insert({{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}, {"e", 5}});
+
+    unique_table copy(ut);
+    EXPECT_EQ(copy.size(), ut.size());
+    EXPECT_EQ(copy.bucket_count(), ut.bucket_count());
+    EXPECT_EQ(copy.max_load_factor(), ut.max_load_factor());
+
+    // The bucket structure and iteration order are cloned exactly.
+    for (size_t bucket = 0; bucket < ut.bucket_count(); ++bucket) {
+        EXPECT_EQ(copy.bucket_size(bucket), ut.bucket_size(bucket));
+    }
+    EXPECT_TRUE(std::equal(ut.begin(), ut.end(), copy.begin()));
+
+    copy.find("a")->second = 100;
+    copy.erase("b");
+    EXPECT_EQ(ut.find("a")->second, 1);
+    EXPECT_TRUE(ut.contains("b"));
+
+    unique_table assigned;
+    assigned.emplace("z", 26);
+    assigned = ut;
+    EXPECT_EQ(assigned.size(), 5);
+    EXPECT_FALSE(assigned.contains("z"));
+    EXPECT_EQ(assigned.find("e")->second, 5);
+}
+
+TEST(Hashtable, CommonCopySmall) {
+    multi_table mt;
+    mt.insert({{"a", 1}, {"a", 2}, {"b", 3}});
+
+    multi_table copy(mt);
+    EXPECT_EQ(copy.bucket_count(), 1);
+    EXPECT_EQ(copy.count("a"), 2);
+    EXPECT_EQ(copy.count("b"), 1);
+
+    copy.emplace("c", 4);
+    EXPECT_FALSE(mt.contains("c"));
+}
+
+TEST(Hashtable, CommonMove) {
+    unique_table ut(32);
+    ut.insert({{"a", 1}, {"b", 2}, {"c", 3}});
+    auto it = ut.find("b");
+
+    unique_table moved(std::move(ut));
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved.bucket_count(), 32);
+    EXPECT_EQ(moved.find("b"), it);
+
+    // The source is left empty and usable.
+    EXPECT_TRUE(ut.empty());
+    EXPECT_EQ(ut.begin(), ut.end());
+    EXPECT_FALSE(ut.contains("a"));
+    ut.emplace("d", 4);
+    EXPECT_EQ(ut.size(), 1);
+
+    unique_table small;
+    small.emplace("x", 1);
+    unique_table assigned(64);
+    assigned.emplace("y", 2);
+    assigned = std::move(small);
+    EXPECT_EQ(assigned.size(), 1);
+    EXPECT_EQ(assigned.bucket_count(), 1);
+    EXPECT_TRUE(assigned.contains("x"));
+    EXPECT_FALSE(assigned.contains("y"));
+    EXPECT_TRUE(small.empty());
+
+    EXPECT_TRUE(std::is_nothrow_move_constructible_v<unique_table>);
+    EXPECT_TRUE(std::is_nothrow_move_assignable_v<unique_table>);
+}
+
+TEST(Hashtable, CommonLongChains) {
+    using int_unique_table =
+        mystd::detail::hashtable<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                 std::hash<int>, true>;
+    using int_multi_table =
+        mystd::detail::hashtable<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                 std::hash<int>, false>;
+
+    // A high load factor gives chains well past the tagged prefix of each bucket.
+    int_unique_table ut;
+    int_multi_table mt;
+    ut.max_load_factor(32.0f);
+    mt.max_load_factor(32.0f);
+
+    std::unordered_set<int> expected;
+    for (int i = 0; i < 600; ++i) {
+        int key = (i * 37) % 401;
+        if (i % 3 == 2) {
+            EXPECT_EQ(ut.erase(key), expected.erase(key));
+            mt.erase(key);
+        } else {
+            EXPECT_EQ(ut.emplace(key, i).second, expected.insert(key).second);
+            mt.emplace(key, i);
+            mt.emplace(key, i);
+        }
+
+        for (int probe = 0; probe < 401; probe += 7) {
+            ASSERT_EQ(ut.contains(probe), expected.contains(probe)) << probe;
+            ASSERT_EQ(mt.contains(probe), expected.contains(probe)) << probe;
+        }
+    }
+
+    EXPECT_EQ(ut.size(), expected.size());
+    for (int key : expected) {
+        EXPECT_EQ(ut.find(key)->first, key);
+        EXPECT_GE(mt.count(key), 2);
+    }
+
+    ut.rehash(4);
+    int_unique_table copy(ut);
+    for (int key = 0; key < 401; ++key) {
+        EXPECT_EQ(ut.contains(key), expected.contains(key));
+        EXPECT_EQ(copy.contains(key), expected.contains(key));
+    }
+}
+
+struct CountingHash {
+    static inline int calls = 0;
+    size_t operator()(const char *key) const noexcept {
+        ++calls;
+        return std::hash<const char *>()(key);
+    }
+};
+
+TEST(Hashtable, CommonHashedKey) {
+    using counting_unique_table =
+        mystd::detail::hashtable<std::pair<const char *, int>, mystd::detail::key_extractor_first,
+                                 CountingHash, true>;
+    using counting_multi_table =
+        mystd::detail::hashtable<std::pair<const char *, int>, mystd::detail::key_extractor_first,
+                                 CountingHash, false>;
+
+    counting_unique_table ut;
+    counting_multi_table mt;
+    ut.emplace("a", 1);
+
+    const char *key = "b";
+    CountingHash::calls = 0;
+    mystd::hashed_key<const char *, CountingHash> hk(key);
+    EXPECT_EQ(CountingHash::calls, 1);
+
+    auto [it, inserted] = ut.emplace(hk, 2);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->second, 2);
+    EXPECT_FALSE(ut.emplace(hk, 3).second);
+    mt.emplace(hk, 1);
+    mt.emplace(hk, 2);
+
+    EXPECT_EQ(ut.find(hk), it);
+    EXPECT_TRUE(ut.contains(hk));
+    EXPECT_EQ(ut.count(hk), 1);
+    EXPECT_EQ(mt.count(hk), 2);
+    EXPECT_EQ(mystd::distance(mt.equal_range(hk).first, mt.equal_range(hk).second), 2);
+    EXPECT_EQ(ut.bucket(hk), mt.bucket(hk));
+    EXPECT_EQ(CountingHash::calls, 1);
+
+    EXPECT_EQ(ut.find(key), it);
+    EXPECT_EQ(ut.erase(hk), 1);
+    EXPECT_EQ(mt.erase(hk), 2);
+    EXPECT_FALSE(ut.contains(hk));
+    EXPECT_TRUE(mt.empty());
+    EXPECT_EQ(ut.size(), 1);
+}
+
+TEST(Hashtable, CommonReseedOnLongChain) {
+    using int_table =
+        mystd::detail::hashtable<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                 std::hash<int>, true>;
+
+    int_table t(1024);
+    std::uint64_t seed = t.seed();
+
+    // Keys crafted against the current seed all land in one bucket.
+    std::vector<int> keys;
+    for (int key = 0; keys.size() < 64; ++key) {
+        if (t.bucket(key) == 0) {
+            keys.push_back(key);
+        }
+    }
+
+    for (int key : keys) {
+        t.emplace(key, key);
+    }
+
+    EXPECT_NE(t.seed(), seed);
+    EXPECT_EQ(t.bucket_count(), 1024);
+    for (int key : keys) {
+        EXPECT_EQ(t.find(key)->second, key);
+        EXPECT_LT(t.bucket_size(t.bucket(key)), 16);
+    }
+}
+
+TEST(Hashtable, CommonNoReseedOnEqualHashes) {
+    struct ConstantHash {
+        size_t operator()(int) const noexcept { return 0; }
+    };
+    using int_table =
+        mystd::detail::hashtable<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                 ConstantHash, true>;
+
+    // Reseeding cannot separate keys whose hashes are equal, so it is not attempted.
+    int_table t;
+    std::uint64_t seed = t.seed();
+    for (int key = 0; key < 100; ++key) {
+        t.emplace(key, key);
+    }
+
+    EXPECT_EQ(t.seed(), seed);
+    for (int key = 0; key < 100; ++key) {
+        EXPECT_EQ(t.find(key)->second, key);
+    }
+}
+
+struct CountedKey {
+    static inline int comparisons = 0;
+    int value;
+
+    bool operator==(const CountedKey &other) const {
+        ++comparisons;
+        return value == other.value;
+    }
+    auto operator<=>(const CountedKey &other) const { return value <=> other.value; }
+};
+
+struct CountedKeyHash {
+    size_t operator()(const CountedKey &) const noexcept { return 0; }
+};
+
+TEST(Hashtable, MultiTreeifiedBucket) {
+    using counted_multi_table =
+        mystd::detail::hashtable<std::pair<CountedKey, int>, mystd::detail::key_extractor_first,
+                                 CountedKeyHash, false>;
+
+    counted_multi_table mt;
+    for (int i = 0; i < 64; ++i) {
+        for (int copy = 0; copy < 3; ++copy) {
+            mt.emplace(CountedKey{(i * 37) % 64}, copy);
+        }
+    }
+
+    // Every key collides, but the bucket is searched by key rather than scanned.
+    CountedKey::comparisons = 0;
+    auto [first, last] = mt.equal_range(CountedKey{63});
+    EXPECT_EQ(mystd::distance(first, last), 3);
+    EXPECT_LT(CountedKey::comparisons, 8);
+    EXPECT_EQ(mt.find(CountedKey{64}), mt.end());
+
+    for (int i = 0; i < 64; i += 2) {
+        EXPECT_EQ(mt.erase(CountedKey{i}), 3);
+    }
+    mt.erase(mt.find(CountedKey{1}));
+
+    counted_multi_table copy(mt);
+    mt.rehash(256);
+    for (int i = 0; i < 64; ++i) {
+        size_t expected = i % 2 == 0 ? 0 : (i == 1 ? 2 : 3);
+        EXPECT_EQ(mt.count(CountedKey{i}), expected) << i;
+        EXPECT_EQ(copy.count(CountedKey{i}), expected) << i;
+    }
+
+    // Shrinking below the threshold reverts to a plain chain.
+    for (int i = 1; i < 62; i += 2) {
+        mt.erase(CountedKey{i});
+    }
+    EXPECT_EQ(mt.size(), 3);
+    EXPECT_EQ(mt.count(CountedKey{63}), 3);
+}
+
+TEST(Hashtable, UniqueTreeifiedBucketOnEqualHashes) {
+    using counted_unique_table =
+        mystd::detail::hashtable<std::pair<CountedKey, int>, mystd::detail::key_extractor_first,
+                                 CountedKeyHash, true>;
+
+    counted_unique_table ut;
+    for (int i = 0; i < 256; ++i) {
+        EXPECT_TRUE(ut.emplace(CountedKey{(i * 37) % 256}, i).second);
+    }
+    EXPECT_FALSE(ut.emplace(CountedKey{5}, 0).second);
+
+    // No seed separates equal hashes, so the bucket is searched by key rather than scanned.
+    CountedKey::comparisons = 0;
+    EXPECT_NE(ut.find(CountedKey{255}), ut.end());
+    EXPECT_EQ(ut.find(CountedKey{256}), ut.end());
+    EXPECT_LT(CountedKey::comparisons, 8);
+
+    for (int i = 0; i < 256; i += 2) {
+        EXPECT_EQ(ut.erase(CountedKey{i}), 1);
+    }
+
+    counted_unique_table copy(ut);
+    ut.rehash(1024);
+    for (int i = 0; i < 256; ++i) {
+        EXPECT_EQ(ut.count(CountedKey{i}), i % 2) << i;
+        EXPECT_EQ(copy.count(CountedKey{i}), i % 2) << i;
+    }
+
+    for (int i = 1; i < 253; i += 2) {
+        ut.erase(CountedKey{i});
+    }
+    EXPECT_EQ(ut.size(), 2);
+    EXPECT_TRUE(ut.contains(CountedKey{253}));
+    EXPECT_TRUE(ut.contains(CountedKey{255}));
+}
+
+struct OrderedKey {
+    static inline size_t comparisons = 0;
+    int value;
+
+    bool operator==(const OrderedKey &other) const {
+        ++comparisons;
+        return value == other.value;
+    }
+    auto operator<=>(const OrderedKey &other) const {
+        ++comparisons;
+        return value <=> other.value;
+    }
+};
+
+// Negative keys all share one hash.
+struct NegativeCollideHash {
+    size_t operator()(const OrderedKey &key) const noexcept {
+        return key.value < 0 ? 0 : static_cast<size_t>(key.value);
+    }
+};
+
+TEST(Hashtable, UniqueEqualHashInsertsStayCheap) {
+    using ordered_table =
+        mystd::detail::hashtable<std::pair<OrderedKey, int>, mystd::detail::key_extractor_first,
+                                 NegativeCollideHash, true>;
+
+    ordered_table t;
+    t.reserve(8192);
+    std::uint64_t seed = t.seed();
+    size_t bucket = t.bucket(OrderedKey{-1});
+
+    OrderedKey::comparisons = 0;
+    constexpr int count = 4096;
+    for (int i = 1; i <= count; ++i) {
+        t.emplace(OrderedKey{-i}, i);
+    }
+
+    // Each insert is a binary search of the indexed bucket, not a scan of its chain.
+    EXPECT_LT(OrderedKey::comparisons, size_t{count} * 32);
+    EXPECT_EQ(t.bucket_size(bucket), count);
+
+    // Crafted keys joining the indexed bucket are searched just as cheaply, so the chain is not
+    // rescanned for them and the table keeps its seed.
+    int added = 0;
+    for (int key = 0; added < 64; ++key) {
+        if (t.bucket(OrderedKey{key}) == bucket) {
+            t.emplace(OrderedKey{key}, key);
+            ++added;
+        }
+    }
+    EXPECT_EQ(t.seed(), seed);
+    EXPECT_EQ(t.size(), count + 64);
+    EXPECT_EQ(t.find(OrderedKey{-count})->second, count);
+}
+
+TEST(Hashtable, CommonStringKeys) {
+    using string_table =
+        mystd::detail::hashtable<std::pair<std::string, int>, mystd::detail::key_extractor_first,
+                                 mystd::short_string_hash, true>;
+
+    std::vector<std::string> keys{"",
+                                  "a",
+                                  std::string("a\0", 2),
+                                  "0123456789abcde",
+                                  "0123456789abcdef",
+                                  "0123456789abcdef-one",
+                                  "0123456789abcdef-two",
+                                  std::string(100, 'x')};
+
+    string_table t;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_TRUE(t.emplace(keys[i], static_cast<int>(i)).second) << i;
+    }
+    for (int i = 0; i < 100; ++i) {
+        t.emplace("key." + std::to_string(i), i);
+    }
+
+    string_table copy(t);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(t.find(keys[i])->second, static_cast<int>(i)) << i;
+        EXPECT_EQ(copy.find(keys[i])->second, static_cast<int>(i)) << i;
+    }
+    EXPECT_EQ(t.find("0123456789abcdef-three"), t.end());
+    EXPECT_EQ(t.find("b"), t.end());
+    EXPECT_EQ(t.find("key.7")->second, 7);
+
+    mystd::short_string_hash hash;
+    EXPECT_EQ(hash("0123456789"), hash(std::string("0123456789")));
+    EXPECT_NE(hash("a"), hash(std::string("a\0", 2)));
+    EXPECT_NE(hash("abcd"), hash("abce"));
+}
+
+TEST(Hashtable, CommonBucketRanges) {
+    using int_multi_table =
+        mystd::detail::hashtable<std::pair<int, int>, mystd::detail::key_extractor_first,
+                                 std::hash<int>, false>;
+
+    int_multi_table t;
+    EXPECT_EQ(t.bucket_ranges(4).size(), 1);
+    EXPECT_EQ(t.bucket_ranges(4)[0].begin(), t.bucket_ranges(4)[0].end());
+
+    for (int i = 0; i < 1000; ++i) {
+        t.emplace(i % 300, i);
+    }
+    EXPECT_EQ(t.bucket_count() & (t.bucket_count() - 1), 0);
+
+    // Every element is visited by exactly one range.
+    std::vector<int> seen(1000);
+    auto ranges = t.bucket_ranges(7);
+    EXPECT_EQ(ranges.size(), 7);
+    for (const auto &range : ranges) {
+        for (auto &[key, value] : range) {
+            EXPECT_EQ(key, value % 300);
+            ++seen[value];
+        }
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), 1000);
+
+    std::atomic<long> sum{0};
+    t.for_each_parallel([&](std::pair<int, int> &kv) { sum += kv.second; }, 4);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+
+    const int_multi_table &ct = t;
+    std::atomic<int> count{0};
+    ct.for_each_parallel([&](const std::pair<int, int> &) { ++count; }, 3);
+    EXPECT_EQ(count, 1000);
+}
@@ -416,3 +416,70 @@ TEST(IteratorConcepts, RandomAccessIteratorConcept) {
     EXPECT_TRUE((std::sized_sentinel_for<MissingNumericOverload, MissingNumericOverload>));
     EXPECT_FALSE(mystd::random_access_iterator<MissingNumericOverload>);
 }
+
+TEST(IteratorConcepts, ContiguousIteratorConcept) {
+    EXPECT_TRUE(mystd::contiguous_iterator<int *>);
+    EXPECT_TRUE(mystd::contiguous_iterator<const int *>);
+
+    static int shared;
+
+    struct Valid : mystd::iterator<mystd::random_access_iterator_tag, int> {
+        using iterator_concept = mystd::contiguous_iterator_tag;
+
+        Valid &operator++() { return *this; }
+        Valid operator++(int) { return *this; }
+
+        reference operator*() const { return shared; }
+        pointer operator->() const { return &shared; }
+        bool operator==(const Valid &other) const { return true; }
+
+        Valid &operator--() { return *this; }
+        Valid operator--(int) { return *this; }
+
+        bool operator<(const Valid &other) const { return true; }
+        bool operator<=(const Valid &other) const { return true; }
+        bool operator>(const Valid &other) const { return false; }
+        bool operator>=(const Valid &other) const { return false; }
+
+        difference_type operator-(const Valid &other) const { return 1; }
+
+        Valid &operator+=(difference_type n) { return *this; }
+        Valid &operator-=(difference_type n) { return *this; }
+
+        Valid operator+(difference_type n) const { return *this; }
+        Valid operator-(difference_type n) const { return *this; }
+
+        reference operator[](difference_type n) const { return shared; }
+    };
+    EXPECT_TRUE(mystd::contiguous_iterator<Valid>);
+
+    // Random access alone does not imply contiguity; the iterator has to opt in.
+    struct NotOptedIn : mystd::iterator<mystd::random_access_iterator_tag, int> {
+        NotOptedIn &operator++() { return *this; }
+        NotOptedIn operator++(int) { return *this; }
+
+        reference operator*() const { return shared; }
+        pointer operator->() const { return &shared; }
+        bool operator==(const NotOptedIn &other) const { return true; }
+
+        NotOptedIn &operator--() { return *this; }
+        NotOptedIn operator--(int) { return *this; }
+
+        bool operator<(const NotOptedIn &other) const { return true; }
+        bool operator<=(const NotOptedIn &other) const { return true; }
+        bool operator>(const NotOptedIn &other) const { return false; }
+        bool operator>=(const NotOptedIn &other) const { return false; }
+
+        difference_type operator-(const NotOptedIn &other) const { return 1; }
+
+        NotOptedIn &operator+=(difference_type n) { return *this; }
+        NotOptedIn &operator-=(difference_type n) { return *this; }
+
+        NotOptedIn operator+(difference_type n) const { return *this; }
+        NotOptedIn operator-(difference_type n) const { return *this; }
+
+        reference operator[](difference_type n) const { return shared; }
+    };
+    EXPECT_TRUE(mystd::random_access_iterator<NotOptedIn>);
+    EXPECT_FALSE(mystd::contiguous_iterator<NotOptedIn>);
+}
@@ -0,0 +1,50 @@
+#include "memory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <new>
+
+TEST(Allocator, AllocateDeallocate) {
+    mystd::allocator<int> alloc;
+    int *p = mystd::allocator_traits<mystd::allocator<int>>::allocate(alloc, 16);
+    for (int i = 0; i < 16; ++i) {
+        p[i] = i;
+    }
+    mystd::allocator_traits<mystd::allocator<int>>::deallocate(alloc, p, 16);
+
+    EXPECT_THROW(alloc.allocate(SIZE_MAX / 2), std::bad_array_new_length);
+
+    struct alignas(64) OverAligned {
+        char bytes[64];
+    };
+    mystd::allocator<OverAligned> aligned;
+    OverAligned *q = aligned.allocate(3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(q) % 64, 0);
+    q = aligned.reallocate(q, 3, 8);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(q) % 64, 0);
+    aligned.deallocate(q, 8);
+}
+
+TEST(Allocator, Reallocate) {
+    using traits = mystd::allocator_traits<mystd::allocator<long>>;
+    mystd::allocator<long> alloc;
+
+    long *p = traits::allocate(alloc, 4);
+    for (int i = 0; i < 4; ++i) {
+        p[i] = i;
+    }
+
+    // A block can always be expanded to the size it was allocated with.
+    EXPECT_TRUE(traits::try_expand(alloc, p, 4, 4));
+
+    p = traits::reallocate(alloc, p, 4, 1024);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(p[i], i);
+    }
+    p[1023] = 1023;
+
+    p = traits::reallocate(alloc, p, 1024, 2);
+    EXPECT_EQ(p[1], 1);
+    traits::deallocate(alloc, p, 2);
+}
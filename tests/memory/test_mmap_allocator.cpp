@@ -0,0 +1,84 @@
+#include "mmap_allocator.hpp"
+#include "vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+TEST(MmapAllocator, Reallocate) {
+    using traits = mystd::allocator_traits<mystd::mmap_allocator<std::uint64_t>>;
+    mystd::mmap_allocator<std::uint64_t> alloc;
+
+    // Small blocks come from malloc(), and move to a mapping once they cross the threshold.
+    constexpr size_t small = 1000;
+    constexpr size_t large = (mystd::mmap_allocator<std::uint64_t>::mmap_threshold / 8) * 4;
+
+    std::uint64_t *p = traits::allocate(alloc, small);
+    for (size_t i = 0; i < small; ++i) {
+        p[i] = i;
+    }
+
+    p = traits::reallocate(alloc, p, small, large);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, 0);
+    for (size_t i = 0; i < small; ++i) {
+        ASSERT_EQ(p[i], i);
+    }
+    for (size_t i = small; i < large; ++i) {
+        p[i] = i;
+    }
+
+    // Mappings grow by remapping and shrink in place.
+    p = traits::reallocate(alloc, p, large, 3 * large);
+    p[3 * large - 1] = 1;
+    std::uint64_t *shrunk = traits::reallocate(alloc, p, 3 * large, large);
+    EXPECT_EQ(shrunk, p);
+    EXPECT_TRUE(traits::try_expand(alloc, p, large, 2 * large));
+    for (size_t i = 0; i < large; ++i) {
+        ASSERT_EQ(p[i], i);
+    }
+
+    p = traits::reallocate(alloc, p, 2 * large, small);
+    EXPECT_EQ(p[small - 1], small - 1);
+    traits::deallocate(alloc, p, small);
+}
+
+TEST(MmapAllocator, OverAligned) {
+    struct alignas(64) Line {
+        char bytes[64];
+    };
+    mystd::mmap_allocator<Line> alloc;
+
+    // Small blocks cannot rely on malloc() for the alignment.
+    for (size_t n = 1; n < 100; ++n) {
+        Line *p = alloc.allocate(n);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, 0) << n;
+        EXPECT_FALSE(alloc.try_expand(p, n, n + 1));
+
+        p = alloc.reallocate(p, n, 2 * n);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, 0) << n;
+        alloc.deallocate(p, 2 * n);
+    }
+}
+
+TEST(MmapAllocator, Vector) {
+    mystd::vector<std::uint32_t, mystd::mmap_allocator<std::uint32_t>> vec;
+    for (std::uint32_t i = 0; i < 1'000'000; ++i) {
+        vec.push_back(i);
+    }
+    vec.resize(500'000);
+    vec.shrink_to_fit();
+    vec.push_back(500'000);
+
+    EXPECT_EQ(vec.size(), 500'001);
+    for (std::uint32_t i = 0; i < vec.size(); ++i) {
+        ASSERT_EQ(vec[i], i);
+    }
+
+    // Elements that are not trivially relocatable can still grow in place.
+    mystd::vector<std::string, mystd::mmap_allocator<std::string>> strings;
+    for (int i = 0; i < 100'000; ++i) {
+        strings.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(strings[99'999], "99999");
+}
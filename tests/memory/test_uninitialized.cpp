@@ -45,6 +45,40 @@ TEST(Memory, UninitializedDefaultConstruct) {
     }
 }
 
+TEST(Memory, UninitializedValueConstruct) {
+    constexpr size_t count = 3;
+    alignas(std::string) std::byte buffer[sizeof(std::string) * count];
+    std::string *dest = reinterpret_cast<std::string *>(buffer);
+
+    mystd::uninitialized_value_construct(dest, dest + count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(dest[i], "");
+    }
+    mystd::destroy(dest, dest + count);
+
+    // Unlike default construction, value construction zeroes trivial types.
+    int ints[4] = {1, 2, 3, 4};
+    mystd::uninitialized_value_construct(ints, ints + 4);
+    for (int value : ints) {
+        EXPECT_EQ(value, 0);
+    }
+}
+
+struct DefaultCounter {
+    static inline int constructions = 0;
+    DefaultCounter() { ++constructions; }
+};
+
+TEST(Memory, UninitializedValueConstructCount) {
+    // Only scalars build a value to fill with; other types are constructed once per element.
+    constexpr size_t count = 3;
+    alignas(DefaultCounter) std::byte buffer[sizeof(DefaultCounter) * count];
+    DefaultCounter *dest = reinterpret_cast<DefaultCounter *>(buffer);
+
+    mystd::uninitialized_value_construct(dest, dest + count);
+    EXPECT_EQ(DefaultCounter::constructions, 3);
+}
+
 TEST(Memory, UninitializedFill) {
     constexpr size_t count = 3;
     alignas(std::string) std::byte buffer[sizeof(std::string) * count];
@@ -202,3 +236,49 @@ TEST(Memory, UninitializedFillExceptionSafety) {
     EXPECT_THROW({ mystd::uninitialized_fill(dest, dest + count, 1); }, std::runtime_error);
     EXPECT_EQ(ConstructCounter::get_count(), 0);
 }
+
+TEST(Memory, UninitializedRelocate) {
+    // Trivially relocatable ranges may overlap.
+    int ints[5] = {1, 2, 3, 4, 5};
+    auto *end = mystd::uninitialized_relocate(ints, ints + 4, ints + 1);
+    EXPECT_EQ(end, ints + 5);
+    EXPECT_EQ(ints[1], 1);
+    EXPECT_EQ(ints[4], 4);
+
+    constexpr size_t count = 3;
+    alignas(std::string) std::byte buffer[sizeof(std::string) * count];
+    alignas(std::string) std::byte src_buffer[sizeof(std::string) * count];
+    std::string *src = reinterpret_cast<std::string *>(src_buffer);
+    std::string *dest = reinterpret_cast<std::string *>(buffer);
+    mystd::uninitialized_fill(src, src + count, std::string(32, 'x'));
+
+    auto result = mystd::uninitialized_relocate(src, src + count, dest);
+    EXPECT_EQ(result, dest + count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(dest[i], std::string(32, 'x'));
+    }
+    mystd::destroy(dest, dest + count);
+}
+
+TEST(Memory, UninitializedBitwise) {
+    // Trivially copyable elements are copied with memcpy and zeroes are filled with memset.
+    long src[4] = {1, 2, 3, 4};
+    long dest[4];
+
+    EXPECT_EQ(mystd::uninitialized_copy(src, src + 4, dest), dest + 4);
+    EXPECT_EQ(dest[3], 4);
+
+    EXPECT_EQ(mystd::uninitialized_move(src, src + 2, dest + 2), dest + 4);
+    EXPECT_EQ(dest[2], 1);
+    EXPECT_EQ(dest[3], 2);
+
+    mystd::uninitialized_fill(dest, dest + 4, 0);
+    for (long value : dest) {
+        EXPECT_EQ(value, 0);
+    }
+
+    mystd::uninitialized_fill(dest, dest + 4, 0x0101);
+    for (long value : dest) {
+        EXPECT_EQ(value, 0x0101);
+    }
+}
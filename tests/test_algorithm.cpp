@@ -71,6 +71,44 @@ TEST(Algorithm, Fill) {
     }
 }
 
+// Trivially copyable elements in contiguous ranges take the memmove and memset paths.
+TEST(Algorithm, BitwiseCopyAndFill) {
+    int src[6]{1, 2, 3, 4, 5, 6};
+    int dest[6]{};
+
+    EXPECT_EQ(mystd::copy(src, src + 6, dest), dest + 6);
+    EXPECT_EQ(mystd::copy(src, src, dest), dest);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(dest[i], i + 1);
+    }
+
+    // Overlapping ranges shift like the element-wise loops do.
+    EXPECT_EQ(mystd::move(dest + 1, dest + 6, dest), dest + 5);
+    EXPECT_EQ(dest[0], 2);
+    EXPECT_EQ(dest[4], 6);
+
+    EXPECT_EQ(mystd::move_backward(src, src + 5, src + 6), src + 1);
+    EXPECT_EQ(src[1], 1);
+    EXPECT_EQ(src[5], 5);
+
+    // Zero and byte-sized values are memset; other values fall back to the loop.
+    mystd::fill(dest, dest + 6, 0);
+    mystd::fill(dest + 1, dest + 3, -1);
+    mystd::fill(dest + 3, dest + 5, 7);
+    int expected[6]{0, -1, -1, 7, 7, 0};
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(dest[i], expected[i]);
+    }
+
+    char chars[4]{};
+    mystd::fill(chars, chars + 3, 'a');
+    EXPECT_STREQ(chars, "aaa");
+
+    double doubles[3]{1.0, 1.0, 1.0};
+    mystd::fill(doubles, doubles + 3, 0);
+    EXPECT_EQ(doubles[2], 0.0);
+}
+
 TEST(Algorithm, SwapRanges) {
     int d1[3]{};
     int d2[3]{1, 2, 3};
@@ -0,0 +1,275 @@
+#include "deque.hpp"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+TEST(Deque, Construction) {
+    mystd::deque<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_EQ(empty.begin(), empty.end());
+
+    mystd::deque<int> counted(3000, 7);
+    EXPECT_EQ(counted.size(), 3000);
+    EXPECT_EQ(counted[2999], 7);
+
+    mystd::deque<std::string> defaulted(5);
+    EXPECT_EQ(defaulted.size(), 5);
+    EXPECT_EQ(defaulted[4], "");
+
+    mystd::deque<int> list = {1, 2, 3};
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 3);
+    EXPECT_EQ(list.at(2), 3);
+    EXPECT_THROW(list.at(3), std::out_of_range);
+}
+
+TEST(Deque, PushAndPopAtBothEnds) {
+    mystd::deque<int> deq;
+    for (int i = 0; i < 5000; ++i) {
+        deq.push_back(i);
+        deq.push_front(-i - 1);
+    }
+
+    ASSERT_EQ(deq.size(), 10000);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(deq[i], i - 5000);
+    }
+
+    // Pushing never moves the elements already there.
+    const int *front = &deq.front();
+    const int *back = &deq.back();
+    for (int i = 0; i < 100000; ++i) {
+        deq.push_back(0);
+        deq.push_front(0);
+    }
+    EXPECT_EQ(*front, -5000);
+    EXPECT_EQ(*back, 4999);
+
+    while (!deq.empty()) {
+        deq.pop_front();
+        deq.pop_back();
+    }
+
+    deq.emplace_front(1);
+    deq.emplace_back(2);
+    EXPECT_EQ(deq, (mystd::deque<int>{1, 2}));
+}
+
+TEST(Deque, Iterators) {
+    using deque = mystd::deque<int>;
+    static_assert(mystd::random_access_iterator<deque::iterator>);
+    static_assert(mystd::random_access_iterator<deque::const_iterator>);
+
+    deque deq;
+    for (int i = 0; i < 3000; ++i) {
+        deq.push_front(2999 - i);
+    }
+
+    auto it = deq.begin();
+    for (int i = 0; i < 3000; ++i, ++it) {
+        ASSERT_EQ(*it, i);
+    }
+    EXPECT_EQ(it, deq.end());
+
+    for (int i = 2999; i >= 0; --i) {
+        ASSERT_EQ(*--it, i);
+    }
+    EXPECT_EQ(it, deq.begin());
+
+    EXPECT_EQ(deq.end() - deq.begin(), 3000);
+    EXPECT_EQ(*(deq.begin() + 2500), 2500);
+    EXPECT_EQ(*(deq.end() - 2500), 500);
+    EXPECT_EQ(*((deq.begin() + 2500) - 2400), 100);
+    EXPECT_EQ(deq.begin()[1024], 1024);
+    EXPECT_EQ(deq.cend() - (deq.begin() + 1024), 3000 - 1024);
+    EXPECT_LT(deq.cbegin() + 1023, deq.end() - 1952);
+    EXPECT_EQ(*deq.rbegin(), 2999);
+
+    std::iota(deq.begin(), deq.end(), 1);
+    EXPECT_EQ(deq.back(), 3000);
+}
+
+TEST(Deque, InsertAndErase) {
+    mystd::deque<std::string> deq = {"a", "b", "c", "d", "e"};
+
+    EXPECT_EQ(*deq.insert(deq.begin() + 1, "x"), "x");
+    EXPECT_EQ(*deq.insert(deq.begin() + 5, "y"), "y");
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"a", "x", "b", "c", "d", "y", "e"}));
+
+    // Arguments referring to elements are read before anything shifts.
+    deq.emplace(deq.begin() + 1, deq[3]);
+    deq.emplace(deq.begin() + 7, deq[0]);
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"a", "c", "x", "b", "c", "d", "y", "a", "e"}));
+
+    EXPECT_EQ(*deq.erase(deq.begin() + 1), "x");
+    EXPECT_EQ(*deq.erase(deq.begin() + 6), "e");
+    auto next = deq.erase(deq.begin() + 1, deq.begin() + 5);
+    EXPECT_EQ(next, deq.begin() + 1);
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"a", "y", "e"}));
+
+    // Erasing an empty range leaves every element alone.
+    for (int k = 0; k <= 3; ++k) {
+        EXPECT_EQ(deq.erase(deq.begin() + k, deq.begin() + k), deq.begin() + k);
+    }
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"a", "y", "e"}));
+
+    deq.insert(deq.begin() + 1, 2, "n");
+    deq.insert(deq.begin() + 4, 3, "m");
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"a", "n", "n", "y", "m", "m", "m", "e"}));
+
+    mystd::deque<std::string> more = {"1", "2", "3"};
+    deq.insert(deq.begin() + 1, more.begin(), more.end());
+    deq.insert(deq.end() - 1, {"4", "5"});
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"a", "1", "2", "3", "n", "n", "y", "m", "m", "m",
+                                              "4", "5", "e"}));
+
+    EXPECT_EQ(mystd::erase(deq, "m"), 3);
+    EXPECT_EQ(mystd::erase_if(deq, [](const std::string &s) { return s.size() == 1 && s < "a"; }),
+              5);
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"a", "n", "n", "y", "e"}));
+
+    // Large erases and inserts cross block boundaries.
+    mystd::deque<int> ints(5000);
+    std::iota(ints.begin(), ints.end(), 0);
+    ints.erase(ints.begin() + 100, ints.begin() + 1100);
+    ints.erase(ints.end() - 1100, ints.end() - 100);
+    EXPECT_EQ(ints.size(), 3000);
+    EXPECT_EQ(ints[99], 99);
+    EXPECT_EQ(ints[100], 1100);
+    EXPECT_EQ(ints[2899], 3899);
+    EXPECT_EQ(ints[2900], 4900);
+
+    ints.insert(ints.begin() + 100, 2000, -1);
+    EXPECT_EQ(ints.size(), 5000);
+    EXPECT_EQ(ints[100], -1);
+    EXPECT_EQ(ints[2099], -1);
+    EXPECT_EQ(ints[2100], 1100);
+}
+
+TEST(Deque, AssignAndResize) {
+    mystd::deque<std::string> deq = {"a", "b", "c"};
+    deq.assign(5, "x");
+    EXPECT_EQ(deq, (mystd::deque<std::string>(5, "x")));
+    deq.assign({"p", "q"});
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"p", "q"}));
+
+    deq.resize(2000, "r");
+    EXPECT_EQ(deq[1999], "r");
+    deq.resize(1);
+    EXPECT_EQ(deq, (mystd::deque<std::string>{"p"}));
+
+    deq.clear();
+    EXPECT_TRUE(deq.empty());
+    deq.push_front("z");
+    EXPECT_EQ(deq.back(), "z");
+    deq.shrink_to_fit();
+    deq.pop_front();
+    deq.shrink_to_fit();
+    EXPECT_TRUE(deq.empty());
+}
+
+TEST(Deque, CopyAndMove) {
+    mystd::deque<std::string> deq;
+    for (int i = 0; i < 1000; ++i) {
+        deq.push_back(std::to_string(i));
+    }
+
+    mystd::deque<std::string> copy(deq);
+    EXPECT_EQ(copy, deq);
+    copy.push_back("more");
+    EXPECT_NE(copy, deq);
+    EXPECT_LT(deq, copy);
+
+    const std::string *front = &deq.front();
+    mystd::deque<std::string> moved(std::move(deq));
+    EXPECT_EQ(&moved.front(), front);
+    EXPECT_TRUE(deq.empty());
+
+    deq = copy;
+    EXPECT_EQ(deq, copy);
+    deq = std::move(moved);
+    EXPECT_EQ(deq.size(), 1000);
+    EXPECT_EQ(&deq.front(), front);
+
+    deq.swap(copy);
+    EXPECT_EQ(deq.size(), 1001);
+    EXPECT_EQ(&copy.front(), front);
+
+    deq = {"z"};
+    EXPECT_EQ(deq.size(), 1);
+}
+
+struct CountingAllocator {
+    using value_type = int;
+    using size_type = size_t;
+
+    static inline int allocations = 0;
+
+    int *allocate(size_type n) {
+        ++allocations;
+        return static_cast<int *>(::operator new(sizeof(int) * n));
+    }
+    void deallocate(int *p, size_type) { ::operator delete(p); }
+
+    bool operator==(const CountingAllocator &) const { return true; }
+};
+
+TEST(Deque, RecyclesBlocks) {
+    mystd::deque<int, CountingAllocator> queue;
+    for (int i = 0; i < 3000; ++i) {
+        queue.push_back(i);
+    }
+
+    // A queue whose size holds steady reuses the blocks it empties.
+    int allocations = CountingAllocator::allocations;
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(queue.front(), i);
+        queue.pop_front();
+        queue.push_back(i + 3000);
+    }
+    EXPECT_EQ(CountingAllocator::allocations, allocations);
+    EXPECT_EQ(queue.size(), 3000);
+}
+
+TEST(Deque, ExceptionSafety) {
+    static int live = 0;
+    static int throw_after = -1;
+    struct Tracker {
+        Tracker() {
+            if (throw_after == 0) {
+                throw std::runtime_error("construction failed");
+            }
+            --throw_after;
+            ++live;
+        }
+        Tracker(const Tracker &) : Tracker() {}
+        Tracker &operator=(const Tracker &) = default;
+        ~Tracker() { --live; }
+    };
+
+    using deque = mystd::deque<Tracker>;
+    constexpr int block = static_cast<int>(deque::block_size);
+    {
+        deque deq(block);
+        throw_after = 0;
+        EXPECT_THROW(deq.emplace_back(), std::runtime_error);
+        EXPECT_THROW(deq.emplace_front(), std::runtime_error);
+        EXPECT_EQ(deq.size(), block);
+
+        // A failed insert removes the elements it had added.
+        throw_after = 3;
+        EXPECT_THROW(deq.insert(deq.begin() + 1, 10, Tracker()), std::runtime_error);
+        EXPECT_EQ(deq.size(), block);
+        EXPECT_EQ(live, block);
+
+        throw_after = block / 2;
+        EXPECT_THROW(deque{deq}, std::runtime_error);
+        EXPECT_EQ(live, block);
+        throw_after = -1;
+    }
+    EXPECT_EQ(live, 0);
+}
@@ -0,0 +1,101 @@
+#include "hash_join.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Order {
+    int customer;
+    int amount;
+};
+
+struct Customer {
+    int id;
+    std::string name;
+};
+
+TEST(HashJoin, MatchesNestedLoop) {
+    std::vector<Customer> customers;
+    for (int id = 0; id < 3000; ++id) {
+        customers.push_back({id % 2500, std::to_string(id)});
+    }
+
+    std::vector<Order> orders;
+    for (int i = 0; i < 20000; ++i) {
+        orders.push_back({(i * 7919) % 4000, i});
+    }
+
+    std::vector<std::pair<std::string, int>> expected;
+    std::multimap<int, const Customer *> by_id;
+    for (const auto &c : customers) {
+        by_id.emplace(c.id, &c);
+    }
+    for (const auto &o : orders) {
+        auto [first, last] = by_id.equal_range(o.customer);
+        for (; first != last; ++first) {
+            expected.emplace_back(first->second->name, o.amount);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    auto key_fn = [](const auto &row) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(row)>, Customer>) {
+            return row.id;
+        } else {
+            return row.customer;
+        }
+    };
+
+    for (std::size_t threads : {1, 4}) {
+        std::vector<std::pair<std::string, int>> joined;
+        std::mutex mutex;
+
+        mystd::hash_join(
+            customers, orders, key_fn,
+            [&](const Customer &c, const Order &o) {
+                std::lock_guard lock(mutex);
+                joined.emplace_back(c.name, o.amount);
+            },
+            threads);
+
+        std::sort(joined.begin(), joined.end());
+        EXPECT_EQ(joined, expected) << threads;
+    }
+}
+
+TEST(HashJoin, EmptyInputs) {
+    std::vector<Order> none;
+    std::vector<Order> some{{1, 1}};
+    int calls = 0;
+
+    auto key_fn = [](const Order &o) { return o.customer; };
+    mystd::hash_join(none, some, key_fn, [&](const Order &, const Order &) { ++calls; });
+    mystd::hash_join(some, none, key_fn, [&](const Order &, const Order &) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(HashGroupBy, Sum) {
+    std::vector<Order> orders;
+    std::map<int, long> expected;
+    for (int i = 0; i < 50000; ++i) {
+        orders.push_back({(i * 31) % 997, i});
+        expected[(i * 31) % 997] += i;
+    }
+
+    for (std::size_t threads : {1, 3}) {
+        auto groups = mystd::hash_group_by<long>(
+            orders, [](const Order &o) { return o.customer; },
+            [](long &sum, const Order &o) { sum += o.amount; }, threads);
+
+        std::map<int, long> actual;
+        for (const auto &[customer, sum] : groups) {
+            EXPECT_TRUE(actual.emplace(customer, sum).second);
+        }
+        EXPECT_EQ(actual, expected) << threads;
+    }
+}
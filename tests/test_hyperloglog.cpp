@@ -0,0 +1,82 @@
+#include "hyperloglog.hpp"
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+#include "vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+TEST(HyperLogLog, Estimate) {
+    mystd::hyperloglog<int> sketch;
+    EXPECT_EQ(sketch.estimate(), 0.0);
+
+    // Every value is added several times; only distinct values count.
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 100000; ++i) {
+            sketch.add(i);
+        }
+    }
+
+    EXPECT_NEAR(sketch.estimate(), 100000, 100000 * 3 * sketch.error());
+}
+
+TEST(HyperLogLog, SmallCardinality) {
+    mystd::hyperloglog<int> sketch;
+    for (int i = 0; i < 50; ++i) {
+        sketch.add(i % 10);
+    }
+
+    EXPECT_NEAR(sketch.estimate(), 10, 1);
+}
+
+TEST(HyperLogLog, Merge) {
+    mystd::hyperloglog<int> lhs;
+    mystd::hyperloglog<int> rhs;
+    for (int i = 0; i < 20000; ++i) {
+        lhs.add(i);
+        rhs.add(i + 10000);
+    }
+
+    lhs.merge(rhs);
+    EXPECT_NEAR(lhs.estimate(), 30000, 30000 * 3 * lhs.error());
+
+    EXPECT_THROW(lhs.merge(mystd::hyperloglog<int>(10)), std::invalid_argument);
+    EXPECT_THROW(mystd::hyperloglog<int>(2), std::invalid_argument);
+
+    lhs.clear();
+    EXPECT_EQ(lhs.estimate(), 0.0);
+}
+
+TEST(HyperLogLog, ReserveEstimated) {
+    mystd::vector<std::pair<int, int>> rows;
+    for (int i = 0; i < 200000; ++i) {
+        rows.emplace_back(i % 20000, i);
+    }
+
+    mystd::unordered_map<int, int> map;
+    map.reserve_estimated(rows.begin(), rows.end());
+
+    // Sized for the distinct keys rather than the rows, and the load never rehashes.
+    size_t bucket_count = map.bucket_count();
+    EXPECT_GE(bucket_count, 20000 / map.max_load_factor());
+    EXPECT_LT(bucket_count, 200000);
+
+    map.insert(rows.begin(), rows.end());
+    EXPECT_EQ(map.size(), 20000);
+    EXPECT_EQ(map.bucket_count(), bucket_count);
+
+    mystd::vector<int> values(rows.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i % 5000);
+    }
+
+    mystd::unordered_set<int, std::hash<int>, mystd::cuckoo_hashing> set;
+    set.reserve_estimated(values.begin(), values.end());
+    bucket_count = set.bucket_count();
+    set.insert(values.begin(), values.end());
+    EXPECT_EQ(set.size(), 5000);
+    EXPECT_EQ(set.bucket_count(), bucket_count);
+}
@@ -0,0 +1,139 @@
+#include "index_map.hpp"
+#include "type_traits.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using index_map = mystd::index_map<int, std::string>;
+
+TEST(IndexMap, Aliases) {
+    EXPECT_TRUE((mystd::is_same_v<index_map::key_type, int>));
+    EXPECT_TRUE((mystd::is_same_v<index_map::mapped_type, std::string>));
+    EXPECT_TRUE((mystd::is_same_v<index_map::value_type, std::pair<int, std::string>>));
+    EXPECT_TRUE((mystd::is_same_v<index_map::iterator, std::pair<int, std::string> *>));
+}
+
+TEST(IndexMap, Emplace) {
+    index_map map;
+
+    auto [it, inserted] = map.emplace(1, "a");
+    EXPECT_EQ(it->first, 1);
+    EXPECT_EQ(it->second, "a");
+    EXPECT_TRUE(inserted);
+
+    auto [existing_it, reinserted] = map.emplace(1, "b");
+    EXPECT_EQ(existing_it, it);
+    EXPECT_EQ(existing_it->second, "a");
+    EXPECT_FALSE(reinserted);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(IndexMap, InsertionOrder) {
+    index_map map;
+    for (int i = 100; i > 0; --i) {
+        map[i] = std::to_string(i);
+    }
+
+    int expected = 100;
+    for (const auto &[k, v] : map) {
+        EXPECT_EQ(k, expected);
+        EXPECT_EQ(v, std::to_string(expected));
+        --expected;
+    }
+}
+
+TEST(IndexMap, SwapErase) {
+    index_map map;
+    map.insert({{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}});
+
+    auto it = map.erase(map.find(2));
+    EXPECT_EQ(it->first, 4);
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_FALSE(map.contains(2));
+
+    std::vector<int> keys;
+    for (const auto &[k, _] : map) {
+        keys.push_back(k);
+    }
+    EXPECT_EQ(keys, (std::vector<int>{1, 4, 3}));
+
+    EXPECT_EQ(map.erase(3), 1);
+    EXPECT_EQ(map.erase(3), 0);
+    EXPECT_EQ(map.at(4), "d");
+}
+
+TEST(IndexMap, ShiftErase) {
+    index_map map;
+    map.insert({{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}});
+
+    auto it = map.shift_erase(map.find(2));
+    EXPECT_EQ(it->first, 3);
+    EXPECT_EQ(map.shift_erase(1), 1);
+
+    std::vector<int> keys;
+    for (const auto &[k, _] : map) {
+        keys.push_back(k);
+    }
+    EXPECT_EQ(keys, (std::vector<int>{3, 4}));
+    EXPECT_EQ(map.find(3)->second, "c");
+    EXPECT_EQ(map.find(4)->second, "d");
+}
+
+TEST(IndexMap, At) {
+    index_map map;
+    map[1] = "a";
+
+    map.at(1) = "b";
+    EXPECT_EQ(map.at(1), "b");
+    EXPECT_THROW(map.at(2), std::out_of_range);
+}
+
+TEST(IndexMap, RandomisedAgainstStd) {
+    mystd::index_map<int, int> map;
+    std::unordered_map<int, int> expected;
+    std::mt19937 rng(42);
+
+    for (int i = 0; i < 20000; ++i) {
+        int key = static_cast<int>(rng() % 512);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            map[key] = i;
+            expected[key] = i;
+            break;
+        case 2:
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+            break;
+        case 3:
+            EXPECT_EQ(map.shift_erase(key), expected.erase(key));
+            break;
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    for (const auto &[k, v] : expected) {
+        auto it = map.find(k);
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(it->second, v);
+    }
+}
+
+TEST(IndexMap, CopyAndClear) {
+    index_map map;
+    map.reserve(64);
+    map.insert({{1, "a"}, {2, "b"}});
+
+    index_map copy = map;
+    copy[3] = "c";
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(copy.size(), 3);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(copy.contains(1));
+}
@@ -0,0 +1,42 @@
+#include "index_set.hpp"
+#include "type_traits.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+// NOTE: These are smoke tests for the wrapper around detail::index_table - see
+// tests/test_index_map.cpp.
+
+using index_set = mystd::index_set<int>;
+
+TEST(IndexSet, Aliases) {
+    EXPECT_TRUE((mystd::is_same_v<index_set::key_type, int>));
+    EXPECT_TRUE((mystd::is_same_v<index_set::value_type, int>));
+    EXPECT_TRUE((mystd::is_same_v<index_set::iterator, const int *>));
+}
+
+TEST(IndexSet, Insert) {
+    index_set set;
+
+    auto [it, inserted] = set.insert(1);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*it, 1);
+
+    set.insert({3, 2, 1});
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{1, 3, 2}));
+}
+
+TEST(IndexSet, Erase) {
+    index_set set;
+    set.insert({1, 2, 3, 4});
+
+    set.erase(1);
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{4, 2, 3}));
+
+    set.shift_erase(4);
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{2, 3}));
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_EQ(set.count(4), 0);
+}
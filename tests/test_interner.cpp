@@ -0,0 +1,83 @@
+#include "interner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+TEST(Interner, InternAndView) {
+    mystd::interner strings;
+
+    auto cpu = strings.intern("cpu.usage");
+    auto mem = strings.intern("mem.usage");
+    EXPECT_NE(cpu, mem);
+    EXPECT_EQ(strings.intern(std::string("cpu.") + "usage"), cpu);
+    EXPECT_EQ(strings.size(), 2);
+
+    EXPECT_EQ(strings.view(cpu), "cpu.usage");
+    EXPECT_EQ(strings[mem], "mem.usage");
+
+    EXPECT_EQ(strings.find("mem.usage"), mem);
+    EXPECT_EQ(strings.find("disk.usage"), std::nullopt);
+    EXPECT_FALSE(strings.contains("disk.usage"));
+
+    EXPECT_THROW(strings.at(2), std::out_of_range);
+}
+
+TEST(Interner, EmptyAndLargeStrings) {
+    mystd::interner strings;
+
+    std::string large(100000, 'x');
+    auto empty = strings.intern("");
+    auto big = strings.intern(large);
+
+    EXPECT_EQ(strings.view(empty), "");
+    EXPECT_EQ(strings.view(big), large);
+    EXPECT_EQ(strings.intern(large), big);
+}
+
+TEST(Interner, ViewsStayValid) {
+    using symbol = mystd::interner::symbol;
+    mystd::interner strings;
+    std::vector<std::string_view> views;
+
+    // Enough to span several arena chunks and index rebuilds.
+    for (int i = 0; i < 20000; ++i) {
+        views.push_back(strings.view(strings.intern("tag." + std::to_string(i))));
+    }
+
+    for (int i = 0; i < 20000; ++i) {
+        EXPECT_EQ(views[i], "tag." + std::to_string(i));
+        EXPECT_EQ(strings.find("tag." + std::to_string(i)), static_cast<symbol>(i));
+    }
+
+    mystd::interner moved(std::move(strings));
+    EXPECT_EQ(moved.view(7).data(), views[7].data());
+
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_FALSE(moved.contains("tag.7"));
+    EXPECT_EQ(moved.intern("tag.7"), 0);
+}
+
+TEST(Interner, InternAfterMove) {
+    mystd::interner a;
+    a.intern("hello");
+
+    mystd::interner b;
+    b = std::move(a);
+    EXPECT_TRUE(a.empty());
+
+    // The moved-from interner no longer writes into the chunk that b took over.
+    auto y = a.intern("world");
+    auto z = b.intern("zzzzz");
+    EXPECT_EQ(a.view(y), "world");
+    EXPECT_EQ(b.view(z), "zzzzz");
+    EXPECT_EQ(b.view(0), "hello");
+
+    mystd::interner c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    auto w = b.intern("again");
+    EXPECT_EQ(b.view(w), "again");
+    EXPECT_EQ(c.view(z), "zzzzz");
+}
@@ -0,0 +1,192 @@
+#include "bits/iterator_concepts.hpp"
+#include "bits/iterator_functions.hpp"
+#include "lru_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using lru_cache = mystd::lru_cache<int, std::string>;
+
+TEST(LruCache, IteratorConcept) {
+    EXPECT_TRUE((mystd::bidirectional_iterator<lru_cache::iterator>));
+    EXPECT_TRUE((mystd::bidirectional_iterator<lru_cache::const_iterator>));
+}
+
+TEST(LruCache, PutAndGet) {
+    lru_cache cache(2);
+
+    auto [it, inserted] = cache.put(1, "a");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, 1);
+    EXPECT_EQ(it->second, "a");
+
+    auto [existing_it, reinserted] = cache.put(1, "b");
+    EXPECT_FALSE(reinserted);
+    EXPECT_EQ(existing_it, it);
+    EXPECT_EQ(cache.size(), 1);
+
+    std::string *value = cache.get(1);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, "b");
+    EXPECT_EQ(cache.get(2), nullptr);
+}
+
+TEST(LruCache, RecencyOrder) {
+    lru_cache cache(3);
+    cache.put(1, "a");
+    cache.put(2, "b");
+    cache.put(3, "c");
+
+    cache.get(1);
+    EXPECT_TRUE(cache.touch(2));
+    EXPECT_FALSE(cache.touch(4));
+
+    // peek() does not affect recency.
+    EXPECT_EQ(*cache.peek(3), "c");
+
+    std::vector<int> order;
+    for (const auto &[k, v] : cache) {
+        order.push_back(k);
+    }
+    EXPECT_EQ(order, (std::vector<int>{2, 1, 3}));
+
+    EXPECT_EQ(cache.rbegin()->first, 3);
+}
+
+TEST(LruCache, CapacityEviction) {
+    std::vector<std::pair<int, std::string>> evicted;
+    auto on_evict = [&](const int &k, std::string &v) { evicted.emplace_back(k, std::move(v)); };
+
+    mystd::lru_cache<int, std::string, std::hash<int>, decltype(on_evict)> cache(2, on_evict);
+    cache.put(1, "a");
+    cache.put(2, "b");
+    cache.get(1);
+    cache.put(3, "c");
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+
+    ASSERT_EQ(evicted.size(), 1);
+    EXPECT_EQ(evicted[0].first, 2);
+    EXPECT_EQ(evicted[0].second, "b");
+}
+
+TEST(LruCache, BatchEviction) {
+    std::vector<int> evicted;
+    auto on_evict = [&](const int &k, std::string &) { evicted.push_back(k); };
+
+    mystd::lru_cache<int, std::string, std::hash<int>, decltype(on_evict)> cache(8, on_evict);
+    for (int i = 0; i < 8; ++i) {
+        cache.put(i, std::to_string(i));
+    }
+
+    EXPECT_EQ(cache.evict(3), 3);
+    EXPECT_EQ(evicted, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(cache.size(), 5);
+
+    cache.set_capacity(2);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(evicted, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+
+    EXPECT_EQ(cache.evict(100), 2);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.begin(), cache.end());
+}
+
+struct CountingHash {
+    static inline int calls = 0;
+
+    size_t operator()(const std::string &key) const noexcept {
+        ++calls;
+        return std::hash<std::string>()(key);
+    }
+};
+
+TEST(LruCache, PutHashesOnce) {
+    mystd::lru_cache<std::string, int, CountingHash> cache(64);
+    cache.reserve(64);
+    for (int i = 0; i < 64; ++i) {
+        cache.put(std::to_string(i), i);
+    }
+
+    // At capacity, each put() hashes its key once, and evicts without hashing the victim.
+    CountingHash::calls = 0;
+    for (int i = 64; i < 1064; ++i) {
+        std::string key = std::to_string(i);
+        if (i % 2 == 0) {
+            cache.put(key, i);
+        } else {
+            cache.put(std::move(key), i);
+        }
+    }
+    EXPECT_EQ(CountingHash::calls, 1000);
+    EXPECT_EQ(cache.size(), 64);
+    EXPECT_EQ(cache.rbegin()->first, "1000");
+
+    CountingHash::calls = 0;
+    cache.put("1063", 0);
+    EXPECT_EQ(CountingHash::calls, 1);
+    EXPECT_EQ(cache.begin()->second, 0);
+}
+
+TEST(LruCache, Erase) {
+    std::vector<int> evicted;
+    auto on_evict = [&](const int &k, std::string &) { evicted.push_back(k); };
+
+    mystd::lru_cache<int, std::string, std::hash<int>, decltype(on_evict)> cache(4, on_evict);
+    cache.put(1, "a");
+    cache.put(2, "b");
+
+    EXPECT_EQ(cache.erase(1), 1);
+    EXPECT_EQ(cache.erase(1), 0);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.begin()->first, 2);
+    EXPECT_TRUE(evicted.empty());
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.begin(), cache.end());
+}
+
+TEST(LruCache, ZeroCapacity) {
+    lru_cache cache(0);
+
+    auto [it, inserted] = cache.put(1, "a");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it, cache.end());
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(LruCache, ThrowingEvictCallback) {
+    bool fail = true;
+    auto on_evict = [&](const int &, std::string &) {
+        if (fail) {
+            throw std::runtime_error("evict failed");
+        }
+    };
+
+    mystd::lru_cache<int, std::string, std::hash<int>, decltype(on_evict)> cache(2, on_evict);
+    cache.put(1, "a");
+    cache.put(2, "b");
+
+    // The entry being evicted stays cached and in recency order.
+    EXPECT_THROW(cache.evict(1), std::runtime_error);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.rbegin()->first, 1);
+
+    EXPECT_THROW(cache.put(3, "c"), std::runtime_error);
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_EQ(mystd::distance(cache.begin(), cache.end()), 3);
+
+    // Once the callback succeeds, the entries left behind can still be evicted.
+    fail = false;
+    EXPECT_EQ(cache.evict(1), 1);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.evict(5), 2);
+    EXPECT_TRUE(cache.empty());
+}
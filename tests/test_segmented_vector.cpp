@@ -0,0 +1,250 @@
+#include "segmented_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+TEST(SegmentedVector, Construction) {
+    mystd::segmented_vector<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.capacity(), 0);
+    EXPECT_EQ(empty.begin(), empty.end());
+
+    mystd::segmented_vector<int> counted(300, 7);
+    EXPECT_EQ(counted.size(), 300);
+    EXPECT_EQ(counted[299], 7);
+
+    mystd::segmented_vector<std::string> defaulted(5);
+    EXPECT_EQ(defaulted.size(), 5);
+    EXPECT_EQ(defaulted[4], "");
+
+    mystd::segmented_vector<int> list = {1, 2, 3};
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 3);
+    EXPECT_EQ(list.at(2), 3);
+    EXPECT_THROW(list.at(3), std::out_of_range);
+}
+
+TEST(SegmentedVector, AddressesAreStable) {
+    mystd::segmented_vector<std::string> vec;
+    vec.push_back("first");
+    const std::string *first = &vec.front();
+
+    for (int i = 0; i < 10000; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+
+    EXPECT_EQ(first, &vec.front());
+    EXPECT_EQ(*first, "first");
+
+    const std::string *hundredth = &vec[100];
+    vec.resize(50000);
+    vec.shrink_to_fit();
+    EXPECT_EQ(hundredth, &vec[100]);
+    EXPECT_EQ(*hundredth, "99");
+
+    // Arguments referring to elements stay valid while the container grows.
+    vec.resize(vec.capacity());
+    vec.emplace_back(vec[1]);
+    EXPECT_EQ(vec.back(), "0");
+}
+
+TEST(SegmentedVector, Indexing) {
+    using vector = mystd::segmented_vector<std::size_t>;
+    constexpr std::size_t first = vector::first_segment_size;
+    EXPECT_EQ(first, 64);
+
+    vector vec;
+    for (std::size_t i = 0; i < 10 * first; ++i) {
+        vec.push_back(i);
+    }
+
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        ASSERT_EQ(vec[i], i);
+    }
+
+    // Segments double in size, so ten segments' worth of elements fit in four segments.
+    EXPECT_EQ(vec.segment_count(), 4);
+    EXPECT_EQ(vec.capacity(), 15 * first);
+    EXPECT_EQ(vec.segment(0).size(), first);
+    EXPECT_EQ(vec.segment(1).size(), 2 * first);
+    EXPECT_EQ(vec.segment(3).size(), 3 * first);
+    EXPECT_EQ(vec.segment(2).front(), 3 * first);
+
+    vec.reserve(16 * first);
+    EXPECT_EQ(vec.capacity(), 31 * first);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 15 * first);
+}
+
+TEST(SegmentedVector, SegmentIteration) {
+    mystd::segmented_vector<int> vec(1000);
+    std::iota(vec.begin(), vec.end(), 0);
+
+    long sum = 0;
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < vec.segment_count(); ++k) {
+        for (int value : vec.segment(k)) {
+            sum += value;
+        }
+        count += vec.segment(k).size();
+    }
+
+    EXPECT_EQ(count, 1000);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST(SegmentedVector, Iterators) {
+    using vector = mystd::segmented_vector<int>;
+    static_assert(mystd::random_access_iterator<vector::iterator>);
+    static_assert(mystd::random_access_iterator<vector::const_iterator>);
+
+    vector vec(1000);
+    std::iota(vec.begin(), vec.end(), 0);
+
+    auto it = vec.begin();
+    for (int i = 0; i < 1000; ++i, ++it) {
+        ASSERT_EQ(*it, i);
+    }
+    EXPECT_EQ(it, vec.end());
+
+    for (int i = 999; i >= 0; --i) {
+        ASSERT_EQ(*--it, i);
+    }
+    EXPECT_EQ(it, vec.begin());
+
+    EXPECT_EQ(vec.end() - vec.begin(), 1000);
+    EXPECT_EQ(*(vec.begin() + 700), 700);
+    EXPECT_EQ(*(vec.end() - 1), 999);
+    EXPECT_EQ(vec.begin()[63], 63);
+    EXPECT_EQ(vec.begin()[64], 64);
+    EXPECT_LT(vec.cbegin(), vec.end());
+    EXPECT_EQ(*vec.rbegin(), 999);
+
+    // Iterators stay valid while elements are appended.
+    vector::const_iterator middle = vec.begin() + 500;
+    vec.resize(100000);
+    EXPECT_EQ(*middle, 500);
+    EXPECT_EQ(*(middle + 50000), 0);
+}
+
+TEST(SegmentedVector, Modifiers) {
+    mystd::segmented_vector<std::string> vec = {"a", "b", "c"};
+    vec.pop_back();
+    EXPECT_EQ(vec, (mystd::segmented_vector<std::string>{"a", "b"}));
+
+    vec.resize(200, "x");
+    EXPECT_EQ(vec[199], "x");
+    vec.resize(1);
+    EXPECT_EQ(vec, (mystd::segmented_vector<std::string>{"a"}));
+
+    std::size_t capacity = vec.capacity();
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), capacity);
+
+    vec.push_back("y");
+    EXPECT_EQ(vec.front(), "y");
+}
+
+TEST(SegmentedVector, CopyAndMove) {
+    mystd::segmented_vector<std::string> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+
+    mystd::segmented_vector<std::string> copy(vec);
+    EXPECT_EQ(copy, vec);
+    copy.push_back("more");
+    EXPECT_NE(copy, vec);
+    EXPECT_LT(vec, copy);
+
+    const std::string *front = &vec.front();
+    mystd::segmented_vector<std::string> moved(std::move(vec));
+    EXPECT_EQ(&moved.front(), front);
+    EXPECT_TRUE(vec.empty());
+
+    vec = copy;
+    EXPECT_EQ(vec, copy);
+    vec = std::move(moved);
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(&vec.front(), front);
+
+    vec.swap(copy);
+    EXPECT_EQ(vec.size(), 101);
+    EXPECT_EQ(&copy.front(), front);
+
+    vec = {"z"};
+    EXPECT_EQ(vec.size(), 1);
+}
+
+// Records which allocator allocated each block, and checks that the same one frees it.
+struct TaggedAllocator {
+    using value_type = int;
+    using size_type = size_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+
+    static inline std::map<int *, int> owners;
+    static inline int mismatches = 0;
+
+    int id = 0;
+
+    int *allocate(size_type n) {
+        int *p = static_cast<int *>(::operator new(sizeof(int) * n));
+        owners[p] = id;
+        return p;
+    }
+    void deallocate(int *p, size_type) {
+        mismatches += owners[p] != id;
+        owners.erase(p);
+        ::operator delete(p);
+    }
+
+    bool operator==(const TaggedAllocator &other) const { return id == other.id; }
+};
+
+TEST(SegmentedVector, CopyAssignPropagatesAllocator) {
+    {
+        mystd::segmented_vector<int, TaggedAllocator> source(1000, 1, TaggedAllocator{1});
+        mystd::segmented_vector<int, TaggedAllocator> target(10, 2, TaggedAllocator{2});
+
+        target = source;
+        EXPECT_EQ(target.get_allocator().id, 1);
+        EXPECT_EQ(target, source);
+    }
+    EXPECT_EQ(TaggedAllocator::mismatches, 0);
+    EXPECT_TRUE(TaggedAllocator::owners.empty());
+}
+
+TEST(SegmentedVector, ExceptionSafety) {
+    static int live = 0;
+    static int throw_after = -1;
+    struct Tracker {
+        Tracker() {
+            if (throw_after == 0) {
+                throw std::runtime_error("construction failed");
+            }
+            --throw_after;
+            ++live;
+        }
+        Tracker(const Tracker &) : Tracker() {}
+        ~Tracker() { --live; }
+    };
+
+    {
+        mystd::segmented_vector<Tracker> vec(100);
+        throw_after = 0;
+        EXPECT_THROW(vec.emplace_back(), std::runtime_error);
+        EXPECT_EQ(vec.size(), 100);
+
+        throw_after = 50;
+        EXPECT_THROW(mystd::segmented_vector<Tracker>{vec}, std::runtime_error);
+        EXPECT_EQ(live, 100);
+        throw_after = -1;
+    }
+    EXPECT_EQ(live, 0);
+}
@@ -0,0 +1,202 @@
+#include "small_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+TEST(SmallVector, Construction) {
+    mystd::small_vector<int, 4> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.is_inline());
+    EXPECT_EQ(empty.capacity(), 4);
+
+    mystd::small_vector<int, 4> counted(3, 7);
+    EXPECT_TRUE(counted.is_inline());
+    EXPECT_EQ(counted, (mystd::small_vector<int, 4>{7, 7, 7}));
+
+    mystd::small_vector<std::string, 4> defaulted(6);
+    EXPECT_FALSE(defaulted.is_inline());
+    EXPECT_EQ(defaulted.size(), 6);
+    EXPECT_EQ(defaulted[5], "");
+
+    mystd::small_vector<int, 2> list = {1, 2, 3};
+    EXPECT_FALSE(list.is_inline());
+    EXPECT_EQ(list.at(2), 3);
+    EXPECT_THROW(list.at(3), std::out_of_range);
+}
+
+TEST(SmallVector, Spill) {
+    mystd::small_vector<std::string, 2> vec;
+    vec.push_back("a");
+    vec.push_back("b");
+    EXPECT_TRUE(vec.is_inline());
+
+    vec.push_back("c");
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_GE(vec.capacity(), 3);
+    EXPECT_EQ(vec, (mystd::small_vector<std::string, 2>{"a", "b", "c"}));
+
+    // Shrinking moves the elements back inline once they fit.
+    vec.pop_back();
+    vec.shrink_to_fit();
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(vec, (mystd::small_vector<std::string, 2>{"a", "b"}));
+
+    vec.reserve(10);
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_EQ(vec.capacity(), 10);
+    EXPECT_EQ(vec.back(), "b");
+}
+
+TEST(SmallVector, CopyAndMove) {
+    mystd::small_vector<std::string, 2> small = {"x"};
+    mystd::small_vector<std::string, 2> large = {"a", "b", "c"};
+
+    mystd::small_vector<std::string, 2> small_copy(small);
+    mystd::small_vector<std::string, 2> large_copy(large);
+    EXPECT_EQ(small_copy, small);
+    EXPECT_EQ(large_copy, large);
+
+    // Heap blocks are stolen; inline elements are moved across.
+    const std::string *heap = large.data();
+    mystd::small_vector<std::string, 2> large_moved(std::move(large));
+    EXPECT_EQ(large_moved.data(), heap);
+    EXPECT_TRUE(large.empty());
+    EXPECT_TRUE(large.is_inline());
+
+    mystd::small_vector<std::string, 2> small_moved(std::move(small));
+    EXPECT_TRUE(small_moved.is_inline());
+    EXPECT_EQ(small_moved[0], "x");
+    EXPECT_TRUE(small.empty());
+
+    small_moved = large_moved;
+    EXPECT_EQ(small_moved, large_copy);
+    small_moved = small_copy;
+    EXPECT_EQ(small_moved, small_copy);
+
+    // Assigning fewer elements keeps the heap block, which the move then steals.
+    EXPECT_FALSE(small_moved.is_inline());
+    large_moved = std::move(small_moved);
+    EXPECT_FALSE(large_moved.is_inline());
+    EXPECT_EQ(large_moved, small_copy);
+    EXPECT_TRUE(small_moved.is_inline());
+
+    large_moved = {"p", "q", "r", "s"};
+    EXPECT_EQ(large_moved.size(), 4);
+}
+
+TEST(SmallVector, Swap) {
+    mystd::small_vector<int, 2> inline_a = {1};
+    mystd::small_vector<int, 2> inline_b = {2, 3};
+    mystd::small_vector<int, 2> heap_a = {4, 5, 6};
+    mystd::small_vector<int, 2> heap_b = {7, 8, 9, 10};
+
+    mystd::swap(inline_a, inline_b);
+    EXPECT_EQ(inline_a, (mystd::small_vector<int, 2>{2, 3}));
+    EXPECT_EQ(inline_b, (mystd::small_vector<int, 2>{1}));
+
+    mystd::swap(inline_a, heap_a);
+    EXPECT_EQ(inline_a, (mystd::small_vector<int, 2>{4, 5, 6}));
+    EXPECT_EQ(heap_a, (mystd::small_vector<int, 2>{2, 3}));
+    EXPECT_TRUE(heap_a.is_inline());
+
+    const int *data = heap_b.data();
+    inline_a.swap(heap_b);
+    EXPECT_EQ(inline_a.data(), data);
+    EXPECT_EQ(heap_b, (mystd::small_vector<int, 2>{4, 5, 6}));
+}
+
+TEST(SmallVector, InsertErase) {
+    mystd::small_vector<std::unique_ptr<int>, 4> ptrs;
+    for (int i = 0; i < 6; ++i) {
+        ptrs.insert(ptrs.begin(), std::make_unique<int>(i));
+    }
+    ptrs.erase(ptrs.begin() + 1);
+    ptrs.erase(ptrs.begin(), ptrs.begin() + 2);
+    EXPECT_EQ(ptrs.size(), 3);
+    EXPECT_EQ(*ptrs[0], 2);
+    EXPECT_EQ(*ptrs[2], 0);
+
+    mystd::small_vector<std::string, 4> strings = {"a", "d"};
+    strings.insert(strings.begin() + 1, {"b", "c"});
+    EXPECT_TRUE(strings.is_inline());
+    strings.insert(strings.end(), 2, strings[0]);
+    EXPECT_EQ(strings, (mystd::small_vector<std::string, 4>{"a", "b", "c", "d", "a", "a"}));
+
+    // Inserting nothing leaves the tail alone.
+    strings.insert(strings.begin() + 1, 0, "x");
+    strings.insert(strings.begin() + 2, strings.begin(), strings.begin());
+    EXPECT_EQ(strings, (mystd::small_vector<std::string, 4>{"a", "b", "c", "d", "a", "a"}));
+
+    strings.resize(2);
+    strings.resize(3, "z");
+    EXPECT_EQ(strings, (mystd::small_vector<std::string, 4>{"a", "b", "z"}));
+
+    strings.clear();
+    EXPECT_TRUE(strings.empty());
+}
+
+TEST(SmallVector, ExceptionSafety) {
+    // Construction throws once throw_after more elements have been constructed.
+    static int live = 0;
+    static int throw_after = -1;
+    struct Tracker {
+        Tracker() {
+            if (throw_after-- == 0) {
+                throw std::runtime_error("construction failed");
+            }
+            ++live;
+        }
+        Tracker(const Tracker &) : Tracker() {}
+        ~Tracker() { --live; }
+    };
+
+    throw_after = 2;
+    EXPECT_THROW((mystd::small_vector<Tracker, 4>(3)), std::runtime_error);
+    EXPECT_EQ(live, 0);
+
+    throw_after = 5;
+    EXPECT_THROW((mystd::small_vector<Tracker, 4>(8)), std::runtime_error);
+    EXPECT_EQ(live, 0);
+
+    // A failed spill leaves the inline elements untouched.
+    throw_after = -1;
+    mystd::small_vector<Tracker, 2> vec(2);
+    throw_after = 1;
+    EXPECT_THROW(vec.reserve(4), std::runtime_error);
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(live, 2);
+}
+
+TEST(SmallVector, UninitializedAppend) {
+    mystd::small_vector<char, 8> buffer;
+    buffer.resize_for_overwrite(4);
+    std::memcpy(buffer.data(), "abcd", 4);
+    EXPECT_TRUE(buffer.is_inline());
+
+    buffer.append_uninitialized(8, [](char *out, size_t count) {
+        std::memset(out, 'x', count);
+        return count;
+    });
+    EXPECT_FALSE(buffer.is_inline());
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), "abcdxxxxxxxx");
+}
+
+TEST(SmallVector, BulkMutation) {
+    mystd::small_vector<std::string, 4> vec;
+    vec.assign(3, "a");
+    EXPECT_TRUE(vec.is_inline());
+    vec.assign({"a", "b", "c", "d", "e"});
+    EXPECT_FALSE(vec.is_inline());
+
+    vec.append_range(mystd::small_vector<std::string, 4>{"f", "g"});
+    EXPECT_EQ(vec.size(), 7);
+
+    EXPECT_EQ(mystd::erase_if(vec, [](const std::string &s) { return s < "c"; }), 2);
+    EXPECT_EQ(*vec.swap_remove(vec.begin()), "g");
+    EXPECT_EQ(vec, (mystd::small_vector<std::string, 4>{"g", "d", "e", "f"}));
+}
@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
+#include <utility>
+
 TEST(TypeTraits, IsSameValue) {
     EXPECT_TRUE((mystd::is_same_v<int, int>));
     EXPECT_FALSE((mystd::is_same_v<int, float>));
@@ -43,3 +47,17 @@ TEST(TypeTraits, RemoveReference) {
     EXPECT_TRUE((mystd::is_same_v<int, mystd::remove_reference_t<int &>>));
     EXPECT_TRUE((mystd::is_same_v<int, mystd::remove_reference_t<int &&>>));
 }
+
+TEST(TypeTraits, IsTriviallyRelocatable) {
+    struct Handle {
+        Handle() = default;
+        Handle(Handle &&) noexcept {}
+    };
+
+    EXPECT_TRUE(mystd::is_trivially_relocatable_v<int>);
+    EXPECT_TRUE((mystd::is_trivially_relocatable_v<std::pair<int, double>>));
+    EXPECT_TRUE(mystd::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    EXPECT_FALSE(mystd::is_trivially_relocatable_v<std::string>);
+    EXPECT_FALSE((mystd::is_trivially_relocatable_v<std::pair<int, std::string>>));
+    EXPECT_FALSE(mystd::is_trivially_relocatable_v<Handle>);
+}
@@ -3,6 +3,7 @@
 #include "unordered_multimap.hpp"
 
 #include <gtest/gtest.h>
+#include <string>
 
 // NOTE: These are smoke tests for the wrapper around detail::hashtable - see
 // tests/hashtable/test_table.cpp.
@@ -86,6 +87,24 @@ TEST(UnorderedMap, Contains) {
     EXPECT_FALSE(map.contains("b"));
 }
 
+TEST(UnorderedMap, HashedKey) {
+    unordered_map map;
+    mystd::unordered_multimap<const char *, int> multimap;
+
+    const char *key = "a";
+    unordered_map::hashed_key_type hk(key);
+    map.emplace(hk, 1);
+    multimap.emplace(hk, 2);
+
+    EXPECT_EQ(map.find(hk)->second, 1);
+    EXPECT_TRUE(multimap.contains(hk));
+    EXPECT_EQ(map.bucket(hk), map.bucket(key));
+
+    EXPECT_EQ(map.erase(hk), 1);
+    EXPECT_EQ(multimap.erase(hk), 1);
+    EXPECT_TRUE(map.empty());
+}
+
 TEST(UnorderedMap, Subscript) {
     unordered_map map;
 
@@ -128,3 +147,53 @@ TEST(UnorderedMap, Count) {
     map.emplace("a", 1);
     EXPECT_EQ(map.count("a"), 1);
 }
+
+TEST(UnorderedMap, CopyAndMove) {
+    auto make = [] {
+        unordered_map map;
+        map.insert({{"a", 1}, {"b", 2}});
+        return map;
+    };
+
+    unordered_map map = make();
+    unordered_map copy = map;
+    copy["c"] = 3;
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(copy.size(), 3);
+
+    unordered_map moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_TRUE(copy.empty());
+}
+
+TEST(UnorderedMap, CuckooEngine) {
+    mystd::unordered_map<int, std::string, std::hash<int>, mystd::cuckoo_hashing> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = std::to_string(i);
+    }
+
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_EQ(map.at(500), "500");
+    EXPECT_THROW(map.at(1000), std::out_of_range);
+    EXPECT_EQ(map.erase(500), 1);
+    EXPECT_FALSE(map.contains(500));
+
+    decltype(map) other;
+    other.emplace(2000, "2000");
+    map.merge(other);
+    EXPECT_TRUE(map.contains(2000));
+    EXPECT_TRUE(other.empty());
+}
+
+TEST(UnorderedMap, ForEachParallel) {
+    mystd::unordered_map<int, int> map;
+    for (int i = 0; i < 10000; ++i) {
+        map.emplace(i, 0);
+    }
+
+    map.for_each_parallel([](std::pair<int, int> &kv) { kv.second = kv.first * 2; }, 4);
+    for (int i = 0; i < 10000; i += 97) {
+        EXPECT_EQ(map.at(i), 2 * i);
+    }
+}
@@ -105,3 +105,14 @@ TEST(UnorderedSet, Count) {
     EXPECT_EQ(set.count(1), 1);
     EXPECT_EQ(set.count(2), 0);
 }
+
+TEST(UnorderedSet, CuckooEngine) {
+    mystd::unordered_set<int, std::hash<int>, mystd::cuckoo_hashing> set;
+    set.insert({1, 2, 3});
+
+    EXPECT_FALSE(set.insert(2).second);
+    EXPECT_TRUE(set.contains(3));
+    set.erase(set.find(3));
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_EQ(set.size(), 2);
+}
@@ -0,0 +1,115 @@
+#include "bits/iterator_concepts.hpp"
+#include "type_traits.hpp"
+#include "unordered_split_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using split_map = mystd::unordered_split_map<int, std::string>;
+
+TEST(UnorderedSplitMap, Aliases) {
+    EXPECT_TRUE((mystd::is_same_v<split_map::key_type, int>));
+    EXPECT_TRUE((mystd::is_same_v<split_map::mapped_type, std::string>));
+    EXPECT_TRUE((mystd::is_same_v<split_map::value_type, std::pair<int, std::string>>));
+}
+
+TEST(UnorderedSplitMap, IteratorConcept) {
+    EXPECT_TRUE((mystd::forward_iterator<split_map::iterator>));
+    EXPECT_TRUE((mystd::forward_iterator<split_map::const_iterator>));
+}
+
+TEST(UnorderedSplitMap, Emplace) {
+    split_map map;
+
+    auto [it, inserted] = map.emplace(1, "a");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, 1);
+    EXPECT_EQ(it->second, "a");
+
+    auto [existing_it, reinserted] = map.emplace(1, "b");
+    EXPECT_FALSE(reinserted);
+    EXPECT_EQ(existing_it, it);
+    EXPECT_EQ(existing_it->second, "a");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(UnorderedSplitMap, ProxyReference) {
+    split_map map;
+    map.insert({{1, "a"}, {2, "b"}});
+
+    for (auto [k, v] : map) {
+        v += std::to_string(k);
+    }
+    EXPECT_EQ(map.at(1), "a1");
+    EXPECT_EQ(map.at(2), "b2");
+
+    map.find(1)->second = "c";
+    EXPECT_EQ(map[1], "c");
+
+    std::pair<int, std::string> copy = *map.find(2);
+    EXPECT_EQ(copy.first, 2);
+    EXPECT_EQ(copy.second, "b2");
+
+    const split_map &cmap = map;
+    EXPECT_EQ(cmap.find(2)->second, "b2");
+    EXPECT_EQ(cmap.find(3), cmap.end());
+}
+
+TEST(UnorderedSplitMap, Erase) {
+    split_map map;
+    map.insert({{1, "a"}, {2, "b"}, {3, "c"}});
+
+    auto it = map.erase(map.find(1));
+    EXPECT_EQ(it->first, 3);
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_EQ(map.erase(2), 0);
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at(3), "c");
+    EXPECT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(UnorderedSplitMap, SubscriptProbesBeforeConstructing) {
+    static int constructed;
+    struct Counted {
+        int value = 0;
+
+        Counted() { ++constructed; }
+    };
+    mystd::unordered_split_map<std::string, Counted> map;
+
+    std::string key = "key";
+    map[key].value = 1;
+    map[std::string("other")].value = 2;
+    EXPECT_EQ(constructed, 2);
+
+    // Hits neither copy the key nor build a value.
+    EXPECT_EQ(map[key].value, 1);
+    EXPECT_EQ(map[std::string("other")].value, 2);
+    EXPECT_EQ(constructed, 2);
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST(UnorderedSplitMap, RandomisedAgainstStd) {
+    mystd::unordered_split_map<int, int> map;
+    std::unordered_map<int, int> expected;
+    std::mt19937 rng(7);
+
+    for (int i = 0; i < 20000; ++i) {
+        int key = static_cast<int>(rng() % 512);
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        } else {
+            map[key] = i;
+            expected[key] = i;
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    for (const auto &[k, v] : expected) {
+        EXPECT_EQ(map.at(k), v);
+    }
+}
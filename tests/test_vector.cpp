@@ -2,10 +2,33 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <ranges>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 
+// Opts in to bitwise relocation, and counts the moves that relocation should make unnecessary.
+struct RelocatableHandle {
+    static inline int moves = 0;
+    std::unique_ptr<int> value;
+
+    RelocatableHandle(int v) : value(std::make_unique<int>(v)) {}
+    RelocatableHandle(RelocatableHandle &&other) noexcept : value(std::move(other.value)) {
+        ++moves;
+    }
+    RelocatableHandle &operator=(RelocatableHandle &&other) noexcept {
+        value = std::move(other.value);
+        ++moves;
+        return *this;
+    }
+};
+
+template <> struct mystd::is_trivially_relocatable<RelocatableHandle> : std::true_type {};
+
 TEST(Vector, DefaultConstructor) {
     mystd::vector<int> vec;
 
@@ -582,3 +605,329 @@ TEST(Vector, Swap) {
     EXPECT_EQ(a.size(), 1);
     EXPECT_EQ(b.size(), 2);
 }
+
+TEST(Vector, TriviallyRelocatable) {
+    EXPECT_TRUE(mystd::is_trivially_relocatable_v<mystd::vector<std::string>>);
+
+    mystd::vector<RelocatableHandle> vec;
+    RelocatableHandle::moves = 0;
+
+    for (int i = 0; i < 10; ++i) {
+        vec.emplace_back(i);
+    }
+    vec.emplace(vec.begin() + 2, 100);
+    vec.erase(vec.begin());
+    vec.erase(vec.begin() + 3, vec.begin() + 5);
+    vec.reserve(64);
+    vec.shrink_to_fit();
+    EXPECT_EQ(RelocatableHandle::moves, 0);
+
+    mystd::vector<int> values;
+    for (const auto &handle : vec) {
+        values.push_back(*handle.value);
+    }
+    EXPECT_EQ(values, (mystd::vector<int>{1, 100, 2, 5, 6, 7, 8, 9}));
+}
+
+TEST(Vector, TriviallyRelocatableInsert) {
+    mystd::vector<std::unique_ptr<int>> ptrs;
+    ptrs.push_back(std::make_unique<int>(1));
+    ptrs.insert(ptrs.begin(), std::make_unique<int>(0));
+    EXPECT_EQ(*ptrs[0], 0);
+    EXPECT_EQ(*ptrs[1], 1);
+
+    mystd::vector<std::pair<int, int>> vec = {{1, 1}, {4, 4}};
+    vec.insert(vec.begin() + 1, 2, vec[1]);
+    EXPECT_EQ(vec, (mystd::vector<std::pair<int, int>>{{1, 1}, {4, 4}, {4, 4}, {4, 4}}));
+
+    mystd::vector<std::pair<int, int>> more = {{2, 2}, {3, 3}};
+    vec.insert(vec.begin() + 1, more.begin(), more.end());
+    EXPECT_EQ(vec.size(), 6);
+    EXPECT_EQ(vec[1], (std::pair<int, int>{2, 2}));
+    EXPECT_EQ(vec[2], (std::pair<int, int>{3, 3}));
+    EXPECT_EQ(vec[3], (std::pair<int, int>{4, 4}));
+}
+
+TEST(Vector, GrowthPolicy) {
+    auto capacities = [](auto vec) {
+        mystd::vector<size_t> seen;
+        for (int i = 0; i < 10; ++i) {
+            vec.push_back(i);
+            if (seen.empty() || seen.back() != vec.capacity()) {
+                seen.push_back(vec.capacity());
+            }
+        }
+        return seen;
+    };
+
+    EXPECT_EQ(capacities(mystd::vector<int>()), (mystd::vector<size_t>{1, 2, 4, 8, 16}));
+    EXPECT_EQ(capacities(mystd::vector<int, mystd::allocator<int>, mystd::exact_growth>()),
+              (mystd::vector<size_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+    EXPECT_EQ(
+        capacities(mystd::vector<int, mystd::allocator<int>, mystd::geometric_growth<3, 2>>()),
+        (mystd::vector<size_t>{1, 2, 3, 4, 6, 9, 13}));
+
+    // Size classes step by a quarter of a power of two up to a page, then by pages.
+    using size_classes = mystd::size_class_growth<mystd::exact_growth>;
+    EXPECT_EQ(size_classes::next_capacity(0, 1, 4), 4);
+    EXPECT_EQ(size_classes::next_capacity(4, 5, 4), 5);
+    EXPECT_EQ(size_classes::next_capacity(40, 41, 4), 48);
+    EXPECT_EQ(size_classes::next_capacity(1024, 1025, 4), 2048);
+
+    // Explicit reservations and inserts of many elements are never rounded below what they need.
+    mystd::vector<int, mystd::allocator<int>, mystd::geometric_growth<3, 2>> vec;
+    vec.reserve(5);
+    EXPECT_EQ(vec.capacity(), 5);
+    vec.insert(vec.end(), 20, 1);
+    EXPECT_EQ(vec.capacity(), 20);
+}
+
+// Over-allocates room for 64 elements, so small blocks can be expanded in place up to that.
+struct Arena {
+    using value_type = std::string;
+    using size_type = size_t;
+
+    static inline int allocations = 0;
+    static inline int expansions = 0;
+
+    std::string *allocate(size_type n) {
+        ++allocations;
+        size_type slots = std::max<size_type>(n, 64);
+        return static_cast<std::string *>(::operator new(sizeof(std::string) * slots));
+    }
+    void deallocate(std::string *p, size_type n) { ::operator delete(p); }
+    bool try_expand(std::string *p, size_type old_n, size_type new_n) {
+        ++expansions;
+        return new_n <= 64;
+    }
+
+    bool operator==(const Arena &other) const { return true; }
+};
+
+TEST(Vector, AllocatorExpansion) {
+    {
+        mystd::vector<std::string, Arena> vec;
+        for (int i = 0; i < 40; ++i) {
+            vec.push_back(std::string(32, 'a' + i % 26));
+        }
+        EXPECT_EQ(Arena::allocations, 1);
+        EXPECT_EQ(Arena::expansions, 6);
+        EXPECT_EQ(vec[39], std::string(32, 'n'));
+
+        // Past the arena, growth falls back to moving into a new block.
+        vec.reserve(100);
+        EXPECT_EQ(Arena::allocations, 2);
+        EXPECT_EQ(vec[0], std::string(32, 'a'));
+    }
+
+    // Without try_expand() or reallocate(), trivially relocatable elements are copied bytewise
+    // into a new block.
+    struct Plain {
+        using value_type = int;
+        using size_type = size_t;
+
+        int *allocate(size_type n) { return static_cast<int *>(::operator new(sizeof(int) * n)); }
+        void deallocate(int *p, size_type n) { ::operator delete(p); }
+
+        bool operator==(const Plain &other) const { return true; }
+    };
+
+    mystd::vector<int, Plain> ints;
+    for (int i = 0; i < 100; ++i) {
+        ints.push_back(i);
+    }
+    ints.shrink_to_fit();
+    EXPECT_EQ(ints.capacity(), 100);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(ints[i], i);
+    }
+}
+
+TEST(Vector, ResizeForOverwrite) {
+    mystd::vector<char> buffer = {'a', 'b'};
+    buffer.resize_for_overwrite(6);
+    EXPECT_EQ(buffer.size(), 6);
+    EXPECT_EQ(buffer[1], 'b');
+    std::memcpy(buffer.data() + 2, "cdef", 4);
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), "abcdef");
+
+    buffer.resize_for_overwrite(3);
+    EXPECT_EQ(buffer.size(), 3);
+
+    // Elements with constructors are still constructed.
+    mystd::vector<std::string> strings;
+    strings.resize_for_overwrite(2);
+    EXPECT_EQ(strings[1], "");
+}
+
+TEST(Vector, AppendUninitialized) {
+    mystd::vector<char> buffer = {'>'};
+
+    auto written = buffer.append_uninitialized(16, [](char *out, size_t count) {
+        std::memcpy(out, "hello", 5);
+        return size_t{5};
+    });
+    EXPECT_EQ(written, 5);
+    EXPECT_GE(buffer.capacity(), 17);
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), ">hello");
+
+    // Nothing is appended if the writer throws.
+    EXPECT_THROW(buffer.append_uninitialized(
+                     4, [](char *, size_t) -> size_t { throw std::runtime_error("read failed"); }),
+                 std::runtime_error);
+    EXPECT_EQ(buffer.size(), 6);
+}
+
+TEST(Vector, Assign) {
+    mystd::vector<std::string> vec = {"a", "b", "c"};
+    const std::string *storage = vec.data();
+    vec.reserve(8);
+    storage = vec.data();
+
+    // Shrinking and growing within the capacity reuses the storage.
+    vec.assign({"x", "y"});
+    EXPECT_EQ(vec, (mystd::vector<std::string>{"x", "y"}));
+    vec.assign(5, "z");
+    EXPECT_EQ(vec, (mystd::vector<std::string>(5, "z")));
+    vec.assign(2, vec[4]);
+    EXPECT_EQ(vec, (mystd::vector<std::string>(2, "z")));
+    EXPECT_EQ(vec.data(), storage);
+
+    mystd::vector<std::string> more(10, "m");
+    vec.assign(more.begin(), more.end());
+    EXPECT_EQ(vec, more);
+
+    class InputIterator : public mystd::iterator<mystd::input_iterator_tag, int> {
+        int *_ptr;
+
+    public:
+        InputIterator(int *ptr) : _ptr(ptr) {}
+
+        reference operator*() const { return *_ptr; }
+
+        InputIterator &operator++() {
+            ++_ptr;
+            return *this;
+        }
+        InputIterator operator++(int) {
+            auto tmp = *this;
+            ++_ptr;
+            return tmp;
+        }
+
+        bool operator==(const InputIterator &other) const { return _ptr == other._ptr; }
+    };
+
+    int shorter[] = {1, 2, 3};
+    mystd::vector<int> ints = {9, 9, 9, 9};
+    ints.assign(InputIterator{shorter}, InputIterator{shorter + 3});
+    EXPECT_EQ(ints, (mystd::vector<int>{1, 2, 3}));
+
+    int longer[] = {4, 5, 6, 7, 8};
+    ints.assign(InputIterator{longer}, InputIterator{longer + 5});
+    EXPECT_EQ(ints, (mystd::vector<int>{4, 5, 6, 7, 8}));
+}
+
+TEST(Vector, AppendRange) {
+    mystd::vector<int> vec = {1, 2};
+
+    vec.append_range(mystd::vector<int>{3, 4});
+    EXPECT_EQ(vec, (mystd::vector<int>{1, 2, 3, 4}));
+
+    // Sized ranges grow once; the exact growth policy makes that visible in the capacity.
+    mystd::vector<int, mystd::allocator<int>, mystd::exact_growth> exact = {1};
+    exact.append_range(std::views::iota(2, 10));
+    EXPECT_EQ(exact.size(), 9);
+    EXPECT_EQ(exact.capacity(), 9);
+    EXPECT_EQ(exact.back(), 9);
+
+    vec.append_range(vec);
+    EXPECT_EQ(vec, (mystd::vector<int>{1, 2, 3, 4, 1, 2, 3, 4}));
+
+    std::istringstream in("5 6");
+    vec.append_range(std::views::istream<int>(in));
+    EXPECT_EQ(vec.size(), 10);
+    EXPECT_EQ(vec.back(), 6);
+}
+
+TEST(Vector, EraseIf) {
+    mystd::vector<std::unique_ptr<int>> ptrs;
+    for (int i = 0; i < 10; ++i) {
+        ptrs.push_back(std::make_unique<int>(i));
+    }
+
+    auto removed = mystd::erase_if(ptrs, [](const auto &ptr) { return *ptr % 3 == 0; });
+    EXPECT_EQ(removed, 4);
+    mystd::vector<int> kept;
+    for (const auto &ptr : ptrs) {
+        kept.push_back(*ptr);
+    }
+    EXPECT_EQ(kept, (mystd::vector<int>{1, 2, 4, 5, 7, 8}));
+
+    EXPECT_EQ(mystd::erase(kept, 4), 1);
+    EXPECT_EQ(mystd::erase(kept, 4), 0);
+    EXPECT_EQ(kept, (mystd::vector<int>{1, 2, 5, 7, 8}));
+}
+
+TEST(Vector, SwapRemove) {
+    mystd::vector<std::string> vec = {"a", "b", "c", "d"};
+
+    auto it = vec.swap_remove(vec.begin() + 1);
+    EXPECT_EQ(*it, "d");
+    EXPECT_EQ(vec, (mystd::vector<std::string>{"a", "d", "c"}));
+
+    it = vec.swap_remove(vec.end() - 1);
+    EXPECT_EQ(it, vec.end());
+    EXPECT_EQ(vec, (mystd::vector<std::string>{"a", "d"}));
+
+    mystd::vector<std::unique_ptr<int>> ptrs;
+    ptrs.push_back(std::make_unique<int>(1));
+    ptrs.push_back(std::make_unique<int>(2));
+    ptrs.swap_remove(ptrs.begin());
+    EXPECT_EQ(ptrs.size(), 1);
+    EXPECT_EQ(*ptrs[0], 2);
+}
+
+TEST(Vector, InsertShiftsTail) {
+    // std::string is not trivially relocatable, so these shift with move_backward.
+    auto make = [] { return mystd::vector<std::string>{"a", "b", "c", "d"}; };
+
+    auto vec = make();
+    vec.insert(vec.begin() + 1, 2, "x");
+    EXPECT_EQ(vec, (mystd::vector<std::string>{"a", "x", "x", "b", "c", "d"}));
+
+    vec = make();
+    vec.insert(vec.begin() + 2, 3, vec[3]);
+    EXPECT_EQ(vec, (mystd::vector<std::string>{"a", "b", "d", "d", "d", "c", "d"}));
+
+    mystd::vector<std::string> more = {"p", "q", "r"};
+    vec = make();
+    vec.insert(vec.begin(), more.begin(), more.begin() + 2);
+    EXPECT_EQ(vec, (mystd::vector<std::string>{"p", "q", "a", "b", "c", "d"}));
+
+    vec = make();
+    vec.insert(vec.begin() + 3, more.begin(), more.end());
+    EXPECT_EQ(vec, (mystd::vector<std::string>{"a", "b", "c", "p", "q", "r", "d"}));
+
+    // Inserting nothing leaves the tail alone.
+    vec = make();
+    EXPECT_EQ(vec.insert(vec.begin() + 1, 0, "x"), vec.begin() + 1);
+    EXPECT_EQ(vec.insert(vec.begin() + 2, more.begin(), more.begin()), vec.begin() + 2);
+    EXPECT_EQ(vec, make());
+}
+
+TEST(Vector, EmplaceAliasing) {
+    // Arguments referring to elements stay valid while the vector grows and shifts.
+    mystd::vector<std::string> strings = {std::string(32, 'a'), std::string(32, 'b')};
+    strings.shrink_to_fit();
+    strings.emplace_back(strings[0]);
+    strings.emplace(strings.begin(), strings.back());
+    EXPECT_EQ(strings[0], std::string(32, 'a'));
+    EXPECT_EQ(strings[3], std::string(32, 'a'));
+
+    mystd::vector<std::pair<int, int>> pairs = {{1, 2}};
+    pairs.shrink_to_fit();
+    pairs.emplace_back(pairs[0]);
+    pairs.emplace(pairs.begin(), pairs[1].second, pairs[0].first);
+    EXPECT_EQ(pairs, (mystd::vector<std::pair<int, int>>{{2, 1}, {1, 2}, {1, 2}}));
+}